@@ -99,8 +99,8 @@ class ASTInterior : public ASTInternal
 
 
 public:
-  ASTInterior(STPMgr *mgr, Kind kind, ASTVec& children)
-      : ASTInternal(mgr, kind), _children(children), _value_width(0), _index_width(0)
+  ASTInterior(STPMgr *mgr, Kind kind, ASTVec&& children)
+      : ASTInternal(mgr, kind), _children(std::move(children)), _value_width(0), _index_width(0)
   {
     is_simplified = false;
     if (kind == NOT)
@@ -115,6 +115,12 @@ public:
     is_simplified = false;
   }
 
+  // Takes the children of a temporary lookup key.
+  ASTInterior(ASTInterior&& int_node) : ASTInternal(int_node), _children(std::move(int_node._children)), _value_width(int_node._value_width), _index_width(int_node._index_width)
+  {
+    is_simplified = false;
+  }
+
   ASTInterior & operator= (const ASTInterior & other) =delete;
 
   virtual ~ASTInterior();
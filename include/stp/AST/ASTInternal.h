@@ -74,11 +74,14 @@ protected:
   // the are NOTs of.
   // 
   uint64_t node_uid;
-  static uint64_t node_uid_cntr;
 
   // reference counting for garbage collection
   uint32_t _ref_count;
 
+  // Dense index into the manager's side tables, see NodeVector. Unlike
+  // node_uid it's reused once the node is deleted.
+  uint32_t node_index;
+
   /*******************************************************************
    * ASTNode is of type BV      <==> ((indexwidth=0)&&(valuewidth>0))*
    * ASTNode is of type ARRAY   <==> ((indexwidth>0)&&(valuewidth>0))*
@@ -134,12 +137,9 @@ protected:
   virtual ASTVec const& GetChildren() const = 0;
 
 public:
-  // Constructor (kind only, empty children, int nodenum)
-  ASTInternal(STPMgr* mgr, Kind kind)
-      : nodeManager(mgr), node_uid(node_uid_cntr+=2),
-         _ref_count(0), _kind(kind), iteration(0)
-  {
-  }
+  // Constructor (kind only, empty children, int nodenum). The node_uid
+  // comes from mgr's counter.
+  ASTInternal(STPMgr* mgr, Kind kind);
 
   // This copies the contents of the child nodes
   // array, along with everything else.  Assigning the smart pointer,
@@ -148,7 +148,7 @@ public:
   // FIXME:  I don't think children need to be copied.
   ASTInternal(const ASTInternal& int_node)
       : nodeManager(int_node.nodeManager), node_uid(int_node.node_uid),
-         _ref_count(0), _kind(int_node._kind), iteration(0)
+         _ref_count(0), node_index(0), _kind(int_node._kind), iteration(0)
 
   {
   }
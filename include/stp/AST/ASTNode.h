@@ -130,6 +130,10 @@ public:
   // Access node number
   unsigned GetNodeNum() const;
 
+  // Dense index of the node in its manager, reused after the node is
+  // deleted. Less than STPMgr::NodeIndexBound().
+  uint32_t GetNodeIndex() const;
+
   // Access kind.
   Kind GetKind() const;
 
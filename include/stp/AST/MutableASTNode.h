@@ -37,7 +37,9 @@ namespace stp
 {
 class MutableASTNode
 {
-  static vector<MutableASTNode*> all;
+  // Every node made since the last cleanup(). Per thread, so solvers on
+  // different threads can remove unconstrained variables at the same time.
+  static thread_local vector<MutableASTNode*> all;
 
 public:
   typedef std::set<MutableASTNode*> ParentsType;
@@ -0,0 +1,139 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef NODEVECTOR_H_
+#define NODEVECTOR_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "stp/AST/ASTNode.h"
+
+namespace stp
+{
+
+// Map from nodes to T, stored as an array indexed by
+// ASTNode::GetNodeIndex(). Node indexes are reused after a node is deleted,
+// so each entry also records the node_uid (ASTNode::Hash()) it was set
+// for; an entry left behind by a deleted node is never returned for the
+// node that takes over its index. Unlike ASTNodeMap this doesn't keep the
+// keys alive.
+//
+// All the keys must belong to the same manager.
+template <class T> class NodeVector
+{
+  struct Entry
+  {
+    // 0 if the entry is unused, node_uids start at 2.
+    uint64_t uid;
+    T value;
+
+    Entry() : uid(0), value() {}
+  };
+
+  std::vector<Entry> entries;
+  size_t count;
+
+public:
+  NodeVector() : count(0) {}
+
+  // NULL if n hasn't been given a value.
+  T* find(const ASTNode& n)
+  {
+    const uint32_t i = n.GetNodeIndex();
+    if (i >= entries.size() || entries[i].uid != n.Hash())
+      return NULL;
+    return &entries[i].value;
+  }
+
+  const T* find(const ASTNode& n) const
+  {
+    return const_cast<NodeVector*>(this)->find(n);
+  }
+
+  bool contains(const ASTNode& n) const { return find(n) != NULL; }
+
+  // Default constructs the value if n hasn't been given one.
+  T& operator[](const ASTNode& n)
+  {
+    const uint32_t i = n.GetNodeIndex();
+    if (i >= entries.size())
+      entries.resize(std::max<size_t>(i + 1, entries.size() * 3 / 2));
+
+    Entry& e = entries[i];
+    if (e.uid != n.Hash())
+    {
+      if (e.uid == 0)
+        count++;
+      e.uid = n.Hash();
+      e.value = T();
+    }
+    return e.value;
+  }
+
+  // Number of entries set, including ones left by deleted nodes.
+  size_t size() const { return count; }
+
+  size_t capacity() const { return entries.size(); }
+
+  void clear()
+  {
+    entries.clear();
+    count = 0;
+  }
+};
+
+// Set of nodes, one bit per node index. A bit can't tell which node set
+// it, so this is only for nodes that stay alive while it's in use, e.g. the
+// visited set of a traversal of one expression.
+class NodeBitset
+{
+  std::vector<uint64_t> words;
+
+public:
+  bool contains(const ASTNode& n) const
+  {
+    const uint32_t i = n.GetNodeIndex();
+    return (i / 64) < words.size() && (words[i / 64] >> (i % 64)) & 1;
+  }
+
+  // Returns true if n wasn't already in the set.
+  bool insert(const ASTNode& n)
+  {
+    const uint32_t i = n.GetNodeIndex();
+    if (i / 64 >= words.size())
+      words.resize(i / 64 + 1);
+    const uint64_t bit = uint64_t(1) << (i % 64);
+    const bool added = (words[i / 64] & bit) == 0;
+    words[i / 64] |= bit;
+    return added;
+  }
+
+  void clear() { words.clear(); }
+};
+
+} // end of namespace
+
+#endif
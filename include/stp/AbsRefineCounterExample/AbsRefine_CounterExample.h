@@ -99,6 +99,14 @@ public:
 
   void ClearCounterExampleMap(void) { CounterExampleMap.clear(); }
 
+  // For models found by another solver, e.g. one in a portfolio. The value
+  // must be a constant.
+  void SetCounterExample(const ASTNode& key, const ASTNode& value)
+  {
+    assert(value.isConstant());
+    CounterExampleMap[key] = value;
+  }
+
   void ClearComputeFormulaMap(void) { ComputeFormulaMap.clear(); }
 
   // Prints the counterexample to stdout
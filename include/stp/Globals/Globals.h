@@ -22,15 +22,16 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
 
-/* This is ABSOLUTELY DISGUSTING!
- * These globals used by the library should
- * be encapsulated in a "Context" class
- * to allow concurrent usage of the STP library
+/* These globals used by the library should
+ * be encapsulated in a "Context" class.
+ * Until then they are thread-local, which allows
+ * one STP instance per thread to be used concurrently.
  */
 
 #ifndef GLOBALS_H
 #define GLOBALS_H
 #include <vector>
+#include <mutex>
 #include "stp/Util/Attributes.h"
 
 /* FIXME: Clients who import this header file have to have
@@ -83,13 +84,18 @@ enum SOLVER_RETURN_TYPE
 DLL_PUBLIC extern std::vector<ASTNode> _empty_ASTVec;
 
 // Needed by the SMTLIB printer
-extern enum inputStatus input_status;
+extern thread_local enum inputStatus input_status;
 
 
-// Useful global variables. Use for parsing only
-DLL_PUBLIC extern STP* GlobalSTP;
-DLL_PUBLIC extern STPMgr* GlobalParserBM;
-DLL_PUBLIC extern Cpp_interface* GlobalParserInterface;
+// Useful global variables. Use for parsing only. They are per-thread, so
+// independent STP instances may be driven from different threads.
+DLL_PUBLIC extern thread_local STP* GlobalSTP;
+DLL_PUBLIC extern thread_local STPMgr* GlobalParserBM;
+DLL_PUBLIC extern thread_local Cpp_interface* GlobalParserInterface;
+
+// The flex/bison generated parsers keep their state in process-wide
+// globals, so only one thread may be parsing at any time.
+DLL_PUBLIC extern std::mutex GlobalParserMutex;
 
 // Function that computes various kinds of statistics for the phases
 // of STP
@@ -0,0 +1,100 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef SHAREDQUERY_H
+#define SHAREDQUERY_H
+
+#include "stp/Util/Attributes.h"
+#include <cstddef>
+#include <string>
+
+namespace stp
+{
+class STP;
+struct SharedQueryHeader;
+
+// A shared-memory segment through which a producer process hands queries
+// to an STP worker process, with no parsing and no pipe in between.
+//
+// The producer creates the segment and writes a query into data() in the
+// format of printer::Binary_Print (vc_serializeExpr), then calls submit().
+// The worker, started as "stp --shm-worker <name>", reads the DAG straight
+// out of the segment, decides it as vc_query would, and writes back the
+// result and, if the query is invalid, a model: the conjunction of
+// "variable = value" over the query's bit-vector and boolean variables,
+// in the same binary format (vc_deserializeExpr reads it). The model is
+// written over the query, which has been read by then.
+//
+// Both sides block on process-shared semaphores in the segment, so one
+// segment carries one query at a time.
+// not copyable
+class SharedQuery
+{
+public:
+  DLL_PUBLIC SharedQuery();
+  DLL_PUBLIC ~SharedQuery();
+
+  // Producer side. Creates the segment name (as for shm_open), with room
+  // for capacity bytes of query or model. It's removed again by the
+  // destructor.
+  DLL_PUBLIC bool create(const char* name, size_t capacity);
+  // Tells the worker that the first length bytes of data() hold a query.
+  DLL_PUBLIC void submit(size_t length);
+  // Waits for the answer: 0 invalid, 1 valid, 2 undecided, 3 timeout, or
+  // -100 if the query couldn't be decided, as for vc_query. -100 is also
+  // given for a query that couldn't be read, and if the worker exits
+  // without answering (once it has started serving).
+  DLL_PUBLIC int waitForResult();
+  // The model, in data(), after waitForResult() returned 0. Empty if it
+  // didn't fit.
+  DLL_PUBLIC size_t modelLength() const;
+  // Asks the worker to return from serve().
+  DLL_PUBLIC void shutdown();
+
+  // Worker side. Opens a segment made by create().
+  DLL_PUBLIC bool open(const char* name);
+  // Answers queries with stp until the producer calls shutdown().
+  DLL_PUBLIC void serve(STP* stp);
+
+  DLL_PUBLIC char* data();
+  DLL_PUBLIC size_t capacity() const;
+
+private:
+  SharedQuery(const SharedQuery&);
+  SharedQuery& operator=(const SharedQuery&);
+
+  void close();
+  bool workerGone();
+
+  SharedQueryHeader* header;
+  size_t mapped_length;
+  // Bytes after the header, from the mapping's length rather than from
+  // the header, which whoever is at the other end can write.
+  size_t data_capacity;
+  std::string created_name;
+};
+} // end namespace stp
+
+#endif
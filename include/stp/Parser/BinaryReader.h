@@ -0,0 +1,53 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef BINARYREADER_H
+#define BINARYREADER_H
+
+#include "stp/AST/AST.h"
+#include "stp/Util/Attributes.h"
+#include <cstddef>
+#include <string>
+
+namespace stp
+{
+class STPMgr;
+
+// Rebuilds in bm a DAG written by printer::Binary_Print, without
+// simplifying it, so it has the same shape as the original. Symbols are
+// looked up by name, so reading into the manager that wrote it gives back
+// the same node. Every node is type checked before it's made, and a
+// symbol that bm already has must have the same widths. Malformed input
+// is a FatalError.
+DLL_PUBLIC ASTNode Binary_Read(STPMgr& bm, const char* data, size_t length);
+
+// As Binary_Read, but malformed input gives false and says what's wrong
+// in error. Whatever nodes were made before the problem was found stay in
+// bm, unused.
+DLL_PUBLIC bool Binary_TryRead(STPMgr& bm, const char* data, size_t length,
+                               ASTNode& result, std::string& error);
+} // end namespace stp
+
+#endif
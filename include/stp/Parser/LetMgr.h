@@ -58,7 +58,7 @@ public:
   ASTNodeSet _parser_symbol_table;
 
   // A let with this name has already been declared.
-  bool isLetDeclared(string s)
+  bool isLetDeclared(const string& s)
   {
     return _letid_expr_map->find(s) != _letid_expr_map->end();
   }
@@ -74,7 +74,7 @@ public:
   ~LETMgr() { delete _letid_expr_map; }
 
   // We know for sure that it's a let.
-  ASTNode resolveLet(const string s)
+  ASTNode resolveLet(const string& s)
   {
     assert(isLetDeclared(s));
     return _letid_expr_map->find(s)->second;
@@ -103,6 +103,15 @@ public:
         _letid_expr_map->erase(s);
       }
     stack.pop();
+
+    // Once the outermost let closes, give back the buckets a big one
+    // needed, rather than keeping them for the rest of the input.
+    if (stack.empty() && _letid_expr_map->empty() &&
+        _letid_expr_map->bucket_count() > 1024)
+      {
+        delete _letid_expr_map;
+        InitializeLetIDMap();
+      }
   }
 
 
@@ -0,0 +1,156 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef SMT2PARSER_H
+#define SMT2PARSER_H
+
+#include "stp/AST/AST.h"
+#include "stp/Util/Attributes.h"
+#include <deque>
+#include <string>
+
+namespace stp
+{
+class Cpp_interface;
+
+// A hand-written recursive-descent parser for the SMT-LIB2 that smt2.y
+// accepts, and an alternative to it. Nodes are built straight through the
+// Cpp_interface it's given, with no heap allocated ASTNodes or ASTVecs per
+// production, and it keeps no global state, so parsers for different
+// STPMgrs can run at the same time. The whole input has to be in memory,
+// so it doesn't answer commands as they're typed like the bison parser.
+// Nesting is handled by recursion, so very deeply nested terms need the
+// stack to match.
+// not copyable
+class SMT2Parser
+{
+public:
+  DLL_PUBLIC explicit SMT2Parser(Cpp_interface& interface);
+
+  // Parses and runs the commands in text, which holds length bytes and is
+  // followed by a NUL. Returns 0 at the end of the input or after (exit),
+  // and 1 after a syntax error, like smt2parse().
+  DLL_PUBLIC int parse(const char* text, size_t length);
+
+private:
+  SMT2Parser(const SMT2Parser&);
+  SMT2Parser& operator=(const SMT2Parser&);
+
+  enum Token
+  {
+    T_END, T_LPAREN, T_RPAREN, T_NUMERAL, T_DECIMAL, T_SYMBOL, T_STRING,
+    T_ATTRIBUTE, T_HEX, T_BINARY
+  };
+
+  // The reserved words and operators a symbol can be.
+  enum Keyword
+  {
+    K_NONE,
+
+    // Commands.
+    K_ASSERT, K_CHECK_SAT, K_CHECK_SAT_ASSUMING, K_DECLARE_CONST,
+    K_DECLARE_FUN, K_DEFINE_FUN, K_ECHO, K_EXIT, K_GET_MODEL, K_GET_VALUE,
+    K_POP, K_PUSH, K_RESET, K_SET_INFO, K_SET_LOGIC, K_SET_OPTION,
+    K_UNSUPPORTED_COMMAND,
+
+    // Sorts.
+    K_BITVEC, K_ARRAY, K_BOOL,
+
+    // Core theory.
+    K_TRUE, K_FALSE, K_NOT, K_AND, K_OR, K_XOR, K_ITE, K_EQ, K_IMPLIES,
+    K_DISTINCT, K_LET, K_UNDERSCORE, K_BANG,
+
+    // Bit-vectors and arrays.
+    K_BV_CONST, K_BVSHL, K_BVLSHR, K_BVASHR, K_BVADD, K_BVSUB, K_BVNOT,
+    K_BVMUL, K_BVUDIV, K_BVSDIV, K_BVUREM, K_BVSREM, K_BVSMOD, K_BVNEG,
+    K_BVAND, K_BVOR, K_BVXOR, K_BVNAND, K_BVNOR, K_BVXNOR, K_CONCAT,
+    K_EXTRACT, K_BVULT, K_BVUGT, K_BVULE, K_BVUGE, K_BVSLT, K_BVSGT,
+    K_BVSLE, K_BVSGE, K_BVCOMP, K_ZERO_EXTEND, K_SIGN_EXTEND, K_REPEAT,
+    K_ROTATE_LEFT, K_ROTATE_RIGHT, K_SELECT, K_STORE
+  };
+  static Keyword classify(const std::string& word);
+
+  struct SyntaxError
+  {
+  };
+
+  // Lexing.
+  void next();
+  Token tok;
+  Keyword keyword;  // For T_SYMBOL.
+  std::string text; // The name, string, attribute or constant digits.
+  unsigned numeral; // For T_NUMERAL.
+  const char* begin;
+  const char* pos;
+  const char* end;
+  const char* token_start;
+
+  // Commands. Returns false after (exit).
+  bool command();
+  void declareFun();
+  void defineFun();
+  void setInfo();
+  void setOption();
+
+  // Expressions.
+  ASTNode expr();
+  ASTNode formula();
+  ASTNode term();
+  ASTNode atom();
+  ASTNode application();
+  ASTNode indexed();
+  ASTNode let();
+  ASTNode named();
+  ASTNode distinct();
+  ASTNode binaryTerm(Kind k);
+  ASTNode comparison(Kind k);
+
+  // Sorts. Bool is 0 wide.
+  bool sort(unsigned& index_width, unsigned& value_width);
+  unsigned bitVectorSort();
+
+  std::string name();
+  unsigned readNumeral();
+  bool isDeclared(const std::string& s);
+  void expect(Token t, const char* what);
+  void close();
+  void skipToClose();
+
+  // Vectors for the children of n-ary operators, one per nesting level,
+  // kept between uses so their storage is reused.
+  std::deque<ASTVec> scratch;
+  size_t scratch_depth;
+  ASTVec& acquire();
+  void release();
+
+  // As smt2.y's yyerror: report, and either carry on or give up.
+  void warn(const std::string& msg);
+  void error(const std::string& msg);
+
+  Cpp_interface& pi;
+};
+} // end namespace stp
+
+#endif
@@ -41,6 +41,9 @@ namespace stp
 void SMTScanString (const char *yy_str);
 void SMT2ScanSctring (const char *yy_str);
 void CVCScanString (const char *yy_str);
+DLL_PUBLIC void SMTScanBuffer (char *buffer, size_t size);
+DLL_PUBLIC void SMT2ScanBuffer (char *buffer, size_t size);
+DLL_PUBLIC void CVCScanBuffer (char *buffer, size_t size);
 DLL_PUBLIC FILE* getCVCIn();
 DLL_PUBLIC FILE* getSMTIn();
 DLL_PUBLIC FILE* getSMT2In();
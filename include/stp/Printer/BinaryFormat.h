@@ -0,0 +1,71 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef BINARYFORMAT_H
+#define BINARYFORMAT_H
+
+#include <cstdint>
+#include <string>
+
+// A compact binary form of an ASTNode DAG, written by
+// printer::Binary_Print and read back by stp::Binary_Read. Each node is
+// written once, after its children, so reading it back is one pass with
+// no parsing. All integers are 32-bit little-endian.
+//
+//   "STPB", version
+//   symbol count, then for each symbol: name length, name bytes
+//   node count, then for each node:
+//     kind (one byte), value width, index width, and then
+//       SYMBOL:            index into the symbol table
+//       BVCONST:           (value width + 7) / 8 bytes, least significant first
+//       TRUE/FALSE/UNDEFINED: nothing
+//       anything else:     child count, child node indices
+//
+// The root is the last node. Kinds are numbered as in ASTKind.kinds, so
+// the version must change whenever that file does.
+
+namespace stp
+{
+namespace binary
+{
+const char MAGIC[4] = {'S', 'T', 'P', 'B'};
+const uint32_t VERSION = 1;
+
+inline void putU32(std::string& out, uint32_t v)
+{
+  const char bytes[4] = {(char)(v & 0xff), (char)((v >> 8) & 0xff),
+                         (char)((v >> 16) & 0xff), (char)(v >> 24)};
+  out.append(bytes, 4);
+}
+
+inline uint32_t getU32(const unsigned char* p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+}
+} // end namespace stp
+
+#endif
@@ -42,7 +42,7 @@ DLL_PUBLIC ostream& PL_Print(ostream& os, const stp::ASTNode& n,  STPMgr* bm, in
 DLL_PUBLIC void PL_Print1(ostream& os, const ASTNode& n, int indentation, bool letize, STPMgr* bm );
 
 ostream& Lisp_Print(ostream& os, const stp::ASTNode& n, int indentation = 0);
-extern stp::ASTNodeSet Lisp_AlreadyPrintedSet;
+extern thread_local stp::ASTNodeSet Lisp_AlreadyPrintedSet;
 ostream& Lisp_Print_indent(ostream& os, const stp::ASTNode& n,
                            int indentation = 0);
 
@@ -56,6 +56,10 @@ DLL_PUBLIC ostream& GDL_Print(ostream& os, const stp::ASTNode n);
 DLL_PUBLIC ostream& GDL_Print(ostream& os, const ASTNode n, std::string (*annotate)(const ASTNode&));
 
 ostream& Bench_Print(ostream& os, const ASTNode n);
+
+// The binary DAG format described in BinaryFormat.h. Appends to out.
+DLL_PUBLIC void Binary_Print(std::string& out, const ASTNode& n);
+DLL_PUBLIC ostream& Binary_Print(ostream& os, const ASTNode& n);
 }
 
 #endif /* PRINTERS_H_ */
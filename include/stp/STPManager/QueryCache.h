@@ -0,0 +1,106 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include "stp/AST/AST.h"
+#include "stp/Globals/Globals.h"
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace stp
+{
+
+// Remembers the answers to recent queries, so that asking the same query
+// again, even about differently named symbols, skips the solver. Queries
+// are compared by a canonical form of their DAG: symbols are numbered in
+// the order they're first reached, and the children of commutative
+// operations are sorted by a hash that ignores the names. The forms are
+// compared in full, so a hash collision can't give a wrong answer. Holds
+// at most "capacity" answers, dropping the least recently used.
+// not copyable
+class QueryCache
+{
+public:
+  struct Key
+  {
+    std::vector<uint64_t> words;
+    uint64_t hash;
+
+    bool operator==(const Key& other) const
+    {
+      return hash == other.hash && words == other.words;
+    }
+  };
+
+  struct Entry
+  {
+    Key key;
+    SOLVER_RETURN_TYPE result;
+
+    // The value of each symbol, in the order makeKey listed them, as 32 bit
+    // chunks with the lowest first. Only kept for INVALID queries whose
+    // counterexample was constructed.
+    bool has_model;
+    std::vector<std::vector<unsigned> > model;
+  };
+
+  explicit QueryCache(size_t capacity);
+
+  // Builds the canonical form of "query", and lists its symbols in the
+  // order the form numbers them.
+  static void makeKey(const ASTNode& query, Key& key, ASTVec& symbols);
+
+  // NULL if there's no answer for "key". Otherwise the entry becomes the
+  // most recently used.
+  const Entry* find(const Key& key);
+
+  // Replaces any answer already held for the key.
+  void insert(const Entry& entry);
+
+  size_t size() const { return entries.size(); }
+  size_t getCapacity() const { return capacity; }
+
+  void clear();
+
+private:
+  QueryCache(const QueryCache&);
+  QueryCache& operator=(const QueryCache&);
+
+  typedef std::list<Entry> EntryList;
+
+  size_t capacity;
+
+  // Most recently used first.
+  EntryList entries;
+  std::unordered_multimap<uint64_t, EntryList::iterator> index;
+
+  EntryList::iterator lookup(const Key& key);
+};
+}
+
+#endif
@@ -0,0 +1,85 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef QUERYCACHEFILE_H
+#define QUERYCACHEFILE_H
+
+#include "stp/STPManager/QueryCache.h"
+#include <string>
+
+namespace stp
+{
+
+// The answers of QueryCache kept in a file, so that they outlive the
+// process and are shared by every process using the same file. Records
+// are only ever appended. Readers map the file, and index the records
+// that have been added since they last looked. Appends take a lock on
+// the whole file, and a record that a crashed writer left half written
+// is cut off by the next writer. A file written by a build that numbers
+// the kinds differently is ignored, and started again by the next
+// append. The file is only meant to be shared by processes on one
+// machine.
+// not copyable
+class QueryCacheFile
+{
+public:
+  explicit QueryCacheFile(const std::string& path);
+  ~QueryCacheFile();
+
+  const std::string& getPath() const { return path; }
+
+  bool find(const QueryCache::Key& key, QueryCache::Entry& entry);
+
+  // Does nothing if the file already has an answer for the key.
+  void append(const QueryCache::Entry& entry);
+
+private:
+  QueryCacheFile(const QueryCacheFile&);
+  QueryCacheFile& operator=(const QueryCacheFile&);
+
+  std::string path;
+  int fd;
+
+  const char* mapped;
+  size_t mapped_size;
+
+  // Where the records that haven't been indexed yet start.
+  size_t scanned;
+
+  // From key hash to the offsets of the records with it.
+  std::unordered_multimap<uint64_t, size_t> index;
+
+  void lock(bool exclusive);
+  void unlock();
+
+  // Maps whatever has been added to the file, and indexes the complete
+  // records in it. Must hold a lock. Returns the size of the file.
+  size_t refresh();
+
+  bool decode(size_t offset, QueryCache::Entry& entry) const;
+};
+}
+
+#endif
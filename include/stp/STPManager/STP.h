@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "stp/AST/AST.h"
 #include "stp/AbsRefineCounterExample/ArrayTransformer.h"
 #include "stp/STPManager/STPManager.h"
+#include "stp/STPManager/QueryCache.h"
+#include "stp/STPManager/QueryCacheFile.h"
 #include "stp/Simplifier/BVSolver.h"
 #include "stp/Simplifier/Simplifier.h"
 #include "stp/ToSat/ASTNode/ToSAT.h"
@@ -38,6 +40,8 @@ THE SOFTWARE.
 
 namespace stp
 {
+class ToSATAIGIncremental;
+
 // not copyable
 // FIXME: This needs a better name
 class STP
@@ -69,6 +73,59 @@ class STP
 
   SATSolver* get_new_sat_solver();
 
+  // Used instead of solve_by_sat_solver when UserFlags.portfolio_threads
+  // is more than one. In Portfolio.cpp.
+  SOLVER_RETURN_TYPE solve_by_portfolio(const ASTNode& original_input);
+
+  // Solves the parts of the input that share no symbols one at a time,
+  // when UserFlags.independence_slicing is set. Returns false, without
+  // solving, if there's only one part. In IndependenceSlicing.cpp.
+  bool solve_by_slices(const ASTNode& inputasserts, const ASTNode& query,
+                       SOLVER_RETURN_TYPE& result);
+
+  // Used instead of TopLevelSTPAux when solving incrementally.
+  SOLVER_RETURN_TYPE solve_incrementally(const ASTNode& original_input,
+                                         const ASTVec& assumptions,
+                                         ASTVec& failed);
+
+  // Kept between queries when UserFlags.incremental_solving is set.
+  SATSolver* incrementalSolver;
+  ToSATAIGIncremental* incrementalToSat;
+
+  // Set by TopLevelSTPWithAssumptions.
+  ASTVec failedAssumptions;
+
+  // Models of the last few satisfiable queries, most recently useful
+  // first, when UserFlags.model_reuse_size is set.
+  typedef vector<std::pair<ASTNode, ASTNode> > Model;
+  std::list<Model> recentModels;
+
+  // In ModelReuse.cpp. On success the model that satisfies the input is
+  // the counterexample.
+  bool tryRecentModels(const ASTNode& original_input);
+  void rememberModel(const ASTNode& original_input);
+
+  // Sets of conjuncts that have been found to be unsatisfiable together,
+  // most recently useful first, when UserFlags.unsat_core_cache_size is
+  // set.
+  std::list<ASTVec> unsatCores;
+
+  // In UnsatCoreCache.cpp.
+  bool coveredByUnsatCore(const ASTVec& conjuncts);
+  void rememberUnsatCore(const ASTVec& core);
+
+  // Answers to earlier queries, when UserFlags.query_cache_size is set.
+  QueryCache* queryCache;
+  QueryCacheFile* queryCacheFile;
+
+  // In QueryCache.cpp. On a hit, sets the result and puts back the model.
+  void updateQueryCaches();
+  bool lookupQueryCache(const QueryCache::Key& key, const ASTVec& symbols,
+                        const ASTNode& original_input,
+                        SOLVER_RETURN_TYPE& result);
+  void storeInQueryCache(const QueryCache::Key& key, const ASTVec& symbols,
+                         SOLVER_RETURN_TYPE result);
+
 public:
 
   STPMgr* bm;
@@ -85,6 +142,10 @@ public:
     tosat = ts;
     arrayTransformer = a;
     Ctr_Example = ce;
+    incrementalSolver = NULL;
+    incrementalToSat = NULL;
+    queryCache = NULL;
+    queryCacheFile = NULL;
   }
 
   STP(STPMgr* b, Simplifier* s, BVSolver* bsolv, ArrayTransformer* a,
@@ -96,15 +157,24 @@ public:
     delete bsolv; // Remove from the constructor later..
     arrayTransformer = a;
     Ctr_Example = ce;
+    incrementalSolver = NULL;
+    incrementalToSat = NULL;
+    queryCache = NULL;
+    queryCacheFile = NULL;
   }
 
   ~STP()
   {
     ClearAllTables();
+    ClearIncrementalState();
+    delete queryCache;
+    delete queryCacheFile;
   }
 
   void deleteObjects()
   {
+    ClearIncrementalState();
+
     delete Ctr_Example;
     Ctr_Example = NULL;
 
@@ -125,6 +195,17 @@ public:
     const ASTNode& query
   );
 
+  // Checks whether the input asserts and all of the assumptions can hold
+  // together, keeping the SAT solver for the next call. If they can't
+  // (VALID), GetFailedAssumptions() gives the assumptions that were
+  // needed to show it.
+  DLL_PUBLIC SOLVER_RETURN_TYPE TopLevelSTPWithAssumptions(
+    const ASTNode& inputasserts,
+    const ASTVec& assumptions
+  );
+
+  const ASTVec& GetFailedAssumptions() const { return failedAssumptions; }
+
   // calls sizeReducing and the bitblasting simplification.
   ASTNode callSizeReducing(ASTNode simplified_solved_InputToSAT,
                            BVSolver* bvSolver, PropagateEqualities* pe,
@@ -141,9 +222,14 @@ public:
       tosat->ClearAllTables();
     if (Ctr_Example != NULL)
       Ctr_Example->ClearAllTables();
+    failedAssumptions.clear();
     // bm->ClearAllTables();
   }
 
+  // Forgets everything that incremental solving has kept from earlier
+  // queries. It isn't touched by ClearAllTables, which runs between them.
+  DLL_PUBLIC void ClearIncrementalState();
+
 };
 } // end of namespace
 #endif
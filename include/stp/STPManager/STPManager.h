@@ -29,12 +29,16 @@ THE SOFTWARE.
 #include "stp/AST/ASTInterior.h"
 #include "stp/AST/ASTSymbol.h"
 #include "stp/AST/ASTBVConst.h"
+#include "stp/AST/NodeVector.h"
 
 #include "stp/STPManager/UserDefinedFlags.h"
 #include "stp/AST/AST.h"
 #include "stp/AST/NodeFactory/HashingNodeFactory.h"
 #include "stp/Sat/SATSolver.h"
 #include "stp/Util/Attributes.h"
+#include "stp/Util/Deadline.h"
+#include "stp/Util/SlabAllocator.h"
+#include "stp/Util/UniqueTable.h"
 
 namespace stp
 {
@@ -44,6 +48,7 @@ namespace stp
 class STPMgr
 {
   friend class ASTNode;
+  friend class ASTInternal;
   friend class ASTInterior;
   friend class ASTBVConst;
   friend class ASTSymbol;
@@ -53,16 +58,23 @@ class STPMgr
 
 private:
   // Typedef for unique Interior node table.
-  typedef std::unordered_set<ASTInterior*, ASTInterior::ASTInteriorHasher,
-                   ASTInterior::ASTInteriorEqual> ASTInteriorSet;
+  typedef UniqueTable<ASTInterior, ASTInterior::ASTInteriorHasher,
+                      ASTInterior::ASTInteriorEqual> ASTInteriorSet;
 
   // Typedef for unique Symbol node (leaf) table.
-  typedef std::unordered_set<ASTSymbol*, ASTSymbol::ASTSymbolHasher,
-                   ASTSymbol::ASTSymbolEqual> ASTSymbolSet;
+  typedef UniqueTable<ASTSymbol, ASTSymbol::ASTSymbolHasher,
+                      ASTSymbol::ASTSymbolEqual> ASTSymbolSet;
 
   // Typedef for unique BVConst node (leaf) table.
-  typedef std::unordered_set<ASTBVConst*, ASTBVConst::ASTBVConstHasher,
-                   ASTBVConst::ASTBVConstEqual> ASTBVConstSet;
+  typedef UniqueTable<ASTBVConst, ASTBVConst::ASTBVConstHasher,
+                      ASTBVConst::ASTBVConstEqual> ASTBVConstSet;
+
+  // The nodes in the unique tables live in these, rather than being
+  // allocated one by one. Declared before the tables so that they're
+  // destroyed last; whatever is still allocated then is freed in bulk.
+  SlabAllocator<sizeof(ASTInterior)> interior_arena;
+  SlabAllocator<sizeof(ASTSymbol)> symbol_arena;
+  SlabAllocator<sizeof(ASTBVConst)> bvconst_arena;
 
   // Unique node tables that enables common subexpression sharing
   ASTInteriorSet _interior_unique_table;
@@ -75,6 +87,26 @@ private:
 
   uint8_t last_iteration;
 
+  // Source of node_uids for the nodes this manager owns. Kept per manager
+  // so that independent instances can create nodes concurrently.
+  uint64_t node_uid_cntr;
+
+  // Node indexes given back by deleted nodes, and one more than the largest
+  // index handed out so far.
+  vector<uint32_t> free_node_indexes;
+  uint32_t node_index_bound;
+
+  uint32_t NewNodeIndex()
+  {
+    if (free_node_indexes.empty())
+      return node_index_bound++;
+    uint32_t result = free_node_indexes.back();
+    free_node_indexes.pop_back();
+    return result;
+  }
+
+  void ReleaseNodeIndex(uint32_t i) { free_node_indexes.push_back(i); }
+
 public:
   HashingNodeFactory* hashingNodeFactory;
   NodeFactory* defaultNodeFactory;
@@ -84,6 +116,9 @@ public:
 
   bool soft_timeout_expired;
 
+  // Set from UserFlags.timeout_max_time while a query is being solved.
+  Deadline deadline;
+
   // No nodes should already have the iteration number that is returned from
   // here. This never returns zero.
   uint8_t getNextIteration()
@@ -123,6 +158,9 @@ public:
 
   size_t getAssertLevel() { return _asserts.size(); }
 
+  // Every live node's GetNodeIndex() is below this.
+  uint32_t NodeIndexBound() const { return node_index_bound; }
+
 private:
   // Stack of Logical Context. each entry in the stack is a logical
   // context. A logical context is a vector of assertions. The
@@ -132,7 +170,7 @@ private:
   vector<ASTVec*> _asserts;
 
   // Memo table that tracks terms already seen
-  ASTNodeMap TermsAlreadySeenMap;
+  NodeVector<ASTNode> TermsAlreadySeenMap;
 
   // The query for the current logical context. BUG probably wrongly handled
   // and gets mixed up with the state, which it shouldn't (otherwise, next
@@ -151,11 +189,12 @@ private:
   // If back_child nodes is NULL, no appending is done.  back_child
   // nodes are not modified.  Then it returns the hashed copy of the
   // node, which is created if necessary.
-  ASTInterior* CreateInteriorNode(Kind kind, ASTInterior* new_node,
+  ASTInterior* CreateInteriorNode(Kind kind, ASTInterior& new_node,
                                   const ASTVec& back_children = _empty_ASTVec);
 
-  // Create unique ASTInterior node.
-  ASTInterior* LookupOrCreateInterior(ASTInterior* n);
+  // Create unique ASTInterior node. key is a temporary, its children are
+  // moved into the new node if there isn't one already.
+  ASTInterior* LookupOrCreateInterior(ASTInterior& key);
 
   // Create unique ASTSymbol node.
   ASTSymbol* LookupOrCreateSymbol(ASTSymbol& s);
@@ -210,7 +249,8 @@ public:
    ****************************************************************/
 
   DLL_PUBLIC STPMgr()
-      :  last_iteration(0), soft_timeout_expired(false),
+      :  last_iteration(0), node_uid_cntr(0), node_index_bound(0),
+        soft_timeout_expired(false),
         _symbol_count(0), CNFFileNameCounter(0)
   {
     ValidFlag = false;
@@ -254,6 +294,10 @@ public:
   ASTNode CreateBVConst(unsigned int width, unsigned long long int bvconst);
   ASTNode charToASTNode(unsigned char* strval, int base, int bit_width);
 
+  // Copies n, which belongs to another STPMgr, into this one. cache holds
+  // the nodes copied so far, and can be shared between calls.
+  ASTNode ImportNode(const ASTNode& n, ASTNodeMap& cache);
+
   /****************************************************************
    * Create Node functions                                        *
    ****************************************************************/
@@ -465,6 +509,11 @@ public:
       std::cerr << "BVConsts:" << _bvconst_unique_table.size()  << " of ";
       std::cerr <<  sizeof(**_bvconst_unique_table.begin()) << " bytes each" << std::endl;
     }
+
+    std::cerr << "Node arenas:"
+              << (interior_arena.bytesReserved() + symbol_arena.bytesReserved() +
+                  bvconst_arena.bytesReserved()) / 1024
+              << " KiB reserved" << std::endl;
   }
 };
 
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include <cassert>
 #include <iostream>
 #include <set>
+#include <sstream>
+#include <vector>
 
 namespace stp
 {
@@ -43,7 +45,14 @@ namespace stp
 struct UserDefinedFlags // not copyable
 {
   UserDefinedFlags(UserDefinedFlags const&) = delete;
-  UserDefinedFlags& operator=(UserDefinedFlags const&) = delete;
+
+private:
+  // Only for the portfolio and parallel bit-blasting, which configure
+  // their workers starting from the caller's settings, and independence
+  // slicing, which puts them back after solving the slices.
+  friend class STP;
+  friend class ToSATAIG;
+  UserDefinedFlags& operator=(UserDefinedFlags const&) = default;
 
 public:
   // collect statistics on certain functions
@@ -54,6 +63,9 @@ public:
 
   int64_t timeout_max_conflicts;
 
+  // Wall-clock milliseconds a query may take, -1 for no limit.
+  int64_t timeout_max_time;
+
   // print DAG nodes
   bool print_nodes_flag ;
 
@@ -67,6 +79,27 @@ public:
   bool bitConstantProp_flag ;
   // AIG rewrites are turned on..
   bool enable_AIG_rewrites_flag ;
+  // The ABC steps run when AIG rewrites are on, in order.
+  enum AIGRewriteStep
+  {
+    REWRITE_STEP = 0,
+    REFACTOR_STEP,
+    BALANCE_STEP
+  };
+  std::vector<AIGRewriteStep> aig_rewrite_steps;
+  // Steps are skipped once the AIG has more AND nodes than this.
+  int aig_rewrite_max_nodes;
+  // Rewriting and refactoring steps stop after this many milliseconds.
+  int aig_rewrite_step_ms;
+  // Merge the AIG nodes that SAT sweeping proves equivalent, just before
+  // the AIG is converted to CNF.
+  bool aig_sweep_flag;
+  // Sweeping is skipped for AIGs with more AND nodes than this.
+  int aig_sweep_max_nodes;
+  // The conflicts allowed for each equivalence check.
+  int aig_sweep_conflicts;
+  // Sweeping stops after this many milliseconds.
+  int aig_sweep_ms;
   bool enable_unconstrained;
   bool enable_ite_context;
   bool enable_aig_core_simplify;
@@ -81,6 +114,12 @@ public:
   bool cBitP_propagateForDivisionByZero ;
   bool traditional_cnf ;
   bool simple_cnf ; // don't use the good AIG based CNF conversion.
+  // Add the clauses to the SAT solver as ABC derives them, rather than
+  // building the whole CNF first.
+  bool cnf_streaming_flag;
+  // Keep the AIG after the first CNF is made, and convert the refinement
+  // axioms to CNF through it, rather than writing clauses for them directly.
+  bool aig_refinement_flag;
 
     // eagerly write through the array's function congruence axioms.
   bool ackermannisation ; 
@@ -124,12 +163,61 @@ public:
   bool smtlib1_parser_flag ;
   bool smtlib2_parser_flag ;
 
+  // Parse SMT-LIB2 files with the hand-written SMT2Parser rather than the
+  // bison parser. Standard input still goes through bison.
+  bool smtlib2_rd_parser_flag;
+
   bool quick_statistics_flag ;
 
   bool exit_after_CNF;
 
   int num_solver_threads;
 
+  // Keep the SAT solver and the bit-blasted AIG between queries, rather
+  // than starting afresh each time.
+  bool incremental_solving;
+
+  // Solve each query with this many differently configured solvers at
+  // once, taking the first answer. 0 or 1 means no portfolio.
+  int portfolio_threads;
+
+  // Bit-blast the conjuncts of the query on this many threads. 0 or 1
+  // means on the solving thread.
+  int bitblast_threads;
+
+  // Before solving, check whether one of the models of this many earlier
+  // satisfiable queries satisfies the query too. 0 means none are kept.
+  int model_reuse_size;
+
+  // Keep this many sets of top-level conjuncts that were unsatisfiable
+  // together, and answer any query with all of one of them as VALID
+  // without solving. Queries are then solved incrementally, with each
+  // conjunct as an assumption, so the simplifications that need the
+  // whole input (solving for variables, propagating equalities, removing
+  // unconstrained variables) aren't done, as with incremental_solving.
+  // That pays off when many queries share cores, and may not otherwise.
+  // 0 means none are kept.
+  int unsat_core_cache_size;
+
+  // Solve the parts of a query that share no symbols separately, so the
+  // parts that don't involve the query can come from the query cache.
+  bool independence_slicing;
+
+  // Remember the answers to this many queries, so that asking one again,
+  // even about differently named symbols, skips solving. 0 means no cache.
+  int query_cache_size;
+
+  // Also keep the answers in this file, where other processes can find
+  // them. Empty means no file.
+  std::string query_cache_file;
+
+  // For long streams of SMT-LIB2 commands. Free what was built for each
+  // check-sat, apart from the model, as soon as it's answered.
+  bool streaming_flag;
+
+  // How the bit-blaster encodes multiplication ("1" to "9", or "13").
+  std::string multiplication_variant;
+
   // Available back-end SAT solvers.
   enum SATSolvers
   {
@@ -148,6 +236,35 @@ public:
            print_STPinput_back_dot_flag || print_STPinput_back_GDL_flag;
   }
 
+  // Sets aig_rewrite_steps from a comma separated script, where "rw" is
+  // rewriting, "rf" refactoring and "b" balancing. An unknown step gives
+  // false, and leaves the steps as they were.
+  bool setAIGRewriteScript(const std::string& script)
+  {
+    std::vector<AIGRewriteStep> steps;
+    std::stringstream in(script);
+    std::string step;
+    while (std::getline(in, step, ','))
+    {
+      if (step == "rw")
+        steps.push_back(REWRITE_STEP);
+      else if (step == "rf")
+        steps.push_back(REFACTOR_STEP);
+      else if (step == "b")
+        steps.push_back(BALANCE_STEP);
+      else if (!step.empty())
+        return false;
+    }
+    aig_rewrite_steps = steps;
+    return true;
+  }
+
+  static const char* aigRewriteStepName(AIGRewriteStep step)
+  {
+    static const char* names[] = {"rw", "rf", "b"};
+    return names[step];
+  }
+
   void disableSimplifications()
   {
     optimize_flag = false;
@@ -166,12 +283,20 @@ public:
     stats_flag = false;
     cinterface_exprdelete_on_flag = true;
     timeout_max_conflicts =-1;
+    timeout_max_time = -1;
     print_nodes_flag = false;
     optimize_flag = true;
     wordlevel_solve_flag =true;
     propagate_equalities = true;
     bitConstantProp_flag = true;
     enable_AIG_rewrites_flag = false;
+    setAIGRewriteScript("rw,rf,b,rw");
+    aig_rewrite_max_nodes = 2000000;
+    aig_rewrite_step_ms = 5000;
+    aig_sweep_flag = false;
+    aig_sweep_max_nodes = 500000;
+    aig_sweep_conflicts = 100;
+    aig_sweep_ms = 10000;
     enable_unconstrained= true;
     enable_ite_context= true;
     enable_aig_core_simplify= false;
@@ -183,6 +308,8 @@ public:
     cBitP_propagateForDivisionByZero = true;
     traditional_cnf = false;
     simple_cnf = false;
+    cnf_streaming_flag = true;
+    aig_refinement_flag = true;
     ackermannisation = false; 
     check_counterexample_flag = false;
     print_counterexample_flag = false;
@@ -203,9 +330,19 @@ public:
     output_bench_flag = false;
     smtlib1_parser_flag = false;
     smtlib2_parser_flag = false;
+    smtlib2_rd_parser_flag = false;
     quick_statistics_flag = false;
     exit_after_CNF =false;
     num_solver_threads =1;
+    incremental_solving = false;
+    portfolio_threads = 0;
+    bitblast_threads = 0;
+    model_reuse_size = 0;
+    unsat_core_cache_size = 0;
+    independence_slicing = false;
+    query_cache_size = 0;
+    streaming_flag = false;
+    multiplication_variant = "7";
 
     #ifdef USE_CRYPTOMINISAT
     solver_to_use = CRYPTOMINISAT5_SOLVER;
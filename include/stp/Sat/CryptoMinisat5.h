@@ -41,6 +41,9 @@ class CryptoMiniSat5 : public SATSolver
 {
   CMSat::SATSolver* s;
 
+  // Whether setMaxConflicts has set a budget.
+  bool conflict_limited;
+
 public:
   CryptoMiniSat5(int num_threads);
 
@@ -54,6 +57,11 @@ public:
 
   bool solve(bool& timeout_expired); // Search without assumptions.
 
+  virtual bool solveWithAssumptions(const vec_literals& assumptions,
+                                    bool& timeout_expired);
+
+  virtual void getFailedAssumptions(vec_literals& failed);
+
   virtual uint8_t modelValue(uint32_t x) const;
 
   virtual uint32_t newVar();
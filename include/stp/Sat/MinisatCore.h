@@ -42,6 +42,11 @@ class MinisatCore : public SATSolver
 {
   Minisat::Solver* s;
 
+  // The number of conflicts to stop at, -1 for no limit.
+  int64_t conflict_limit;
+
+  Minisat::lbool solveLimited(const vec_literals& assumptions);
+
 public:
   MinisatCore();
 
@@ -53,6 +58,11 @@ public:
 
   bool solve(bool& timeout_expired); // Search without assumptions.
 
+  virtual bool solveWithAssumptions(const vec_literals& assumptions,
+                                    bool& timeout_expired);
+
+  virtual void getFailedAssumptions(vec_literals& failed);
+
   bool propagateWithAssumptions(const stp::SATSolver::vec_literals & assumps);
 
   virtual void setMaxConflicts(int64_t max_confl);
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "minisat/mtl/Vec.h"
 #include "minisat/core/SolverTypes.h"
+#include "stp/Util/Deadline.h"
 #include <iostream>
 
 // Don't let the defines escape outside.
@@ -39,8 +40,12 @@ private:
   SATSolver(const SATSolver&);      // no copy
   void operator=(const SATSolver&); // no assign.
 
+protected:
+  // If set, searching gives up when it passes, as if out of conflicts.
+  Deadline* deadline;
+
 public:
-  SATSolver() {}
+  SATSolver() : deadline(NULL) {}
 
   virtual ~SATSolver() {}
 
@@ -55,6 +60,26 @@ public:
 
   virtual bool solve(bool& timeout_expired) = 0; // Search without assumptions.
 
+  // Search with the given literals temporarily assumed true. Unlike an
+  // unsatisfiable solve(), an unsatisfiable result here leaves the solver
+  // okay(), so it can keep being used with different assumptions.
+  virtual bool solveWithAssumptions(const vec_literals& /*assumptions*/,
+                                    bool& /*timeout_expired*/)
+  {
+    std::cerr << "Solving with assumptions is not supported by this SAT solver"
+              << std::endl;
+    exit(1);
+  }
+
+  // After solveWithAssumptions() has found the assumptions unsatisfiable,
+  // gives a subset of them that is enough on its own to be unsatisfiable.
+  virtual void getFailedAssumptions(vec_literals& /*failed*/)
+  {
+    std::cerr << "Failed assumptions are not supported by this SAT solver"
+              << std::endl;
+    exit(1);
+  }
+
   typedef uint8_t lbool;
 
   static inline Minisat::Lit mkLit(uint32_t var, bool sign)
@@ -71,6 +96,8 @@ public:
     << std::endl;
   }
 
+  void setDeadline(Deadline* d) { deadline = d; }
+
   virtual uint8_t modelValue(uint32_t x) const = 0;
 
   virtual uint32_t newVar() = 0;
@@ -38,6 +38,11 @@ class SimplifyingMinisat : public SATSolver
 {
   Minisat::SimpSolver* s;
 
+  // The number of conflicts to stop at, -1 for no limit.
+  int64_t conflict_limit;
+
+  Minisat::lbool solveLimited(const vec_literals& assumptions);
+
 public:
   SimplifyingMinisat();
   ~SimplifyingMinisat();
@@ -48,6 +53,11 @@ public:
 
   bool solve(bool& timeout_expired); // Search without assumptions.
 
+  virtual bool solveWithAssumptions(const vec_literals& assumptions,
+                                    bool& timeout_expired);
+
+  virtual void getFailedAssumptions(vec_literals& failed);
+
   bool simplify(); // Removes already satisfied clauses.
 
   virtual void setMaxConflicts(int64_t max_confl);
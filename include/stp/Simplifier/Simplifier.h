@@ -47,8 +47,8 @@ private:
 
   // Memo table for simplifcation. Key is unsimplified node, and
   // value is simplified node.
-  ASTNodeMap* SimplifyMap;
-  ASTNodeMap* SimplifyNegMap;
+  NodeVector<ASTNode>* SimplifyMap;
+  NodeVector<ASTNode>* SimplifyNegMap;
   std::unordered_set<int> AlwaysTrueHashSet;
   ASTNodeMap MultInverseMap;
 
@@ -87,8 +87,8 @@ public:
 
   Simplifier(STPMgr* bm) : _bm(bm), substitutionMap(this, bm)
   {
-    SimplifyMap = new ASTNodeMap(INITIAL_TABLE_SIZE);
-    SimplifyNegMap = new ASTNodeMap(INITIAL_TABLE_SIZE);
+    SimplifyMap = new NodeVector<ASTNode>();
+    SimplifyNegMap = new NodeVector<ASTNode>();
     // ReadOverWrite_NewName_Map = new ASTNodeMap();
 
     ASTTrue = bm->CreateNode(TRUE);
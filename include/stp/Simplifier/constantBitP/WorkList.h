@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "stp/AST/ASTNode.h"
 #include "stp/AST/AST.h"
+#include "stp/AST/NodeVector.h"
 
 namespace simplifier
 {
@@ -52,16 +53,14 @@ private:
   WorkList& operator=(const WorkList&);
 
   // We add to the worklist any node that immediately depends on a constant.
-  void addToWorklist(const stp::ASTNode& n, stp::ASTNodeSet& visited)
+  void addToWorklist(const stp::ASTNode& n, stp::NodeBitset& visited)
   {
     if (n.isConstant())
       return;
 
-    if (visited.find(n) != visited.end())
+    if (!visited.insert(n))
       return;
 
-    visited.insert(n);
-
     bool alreadyAdded = false;
 
     for (unsigned i = 0; i < n.GetChildren().size(); i++)
@@ -84,7 +83,7 @@ public:
 
   void initWorkList(const ASTNode& n)
   {
-    stp::ASTNodeSet visited;
+    stp::NodeBitset visited;
     addToWorklist(n, visited);
   }
 
@@ -0,0 +1,105 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef AIGSIMULATOR_H_
+#define AIGSIMULATOR_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "extlib-abc/aig.h"
+
+namespace stp
+{
+
+// Simulates an AIG on many input patterns at once. Each object has
+// words() 64-bit words of values, one bit to a pattern, so 4 words are 256
+// patterns and 8 are 512. The nodes are evaluated with AVX-512 or AVX2
+// when the CPU has them, and a word at a time otherwise.
+//
+// The AIG mustn't change while it's being simulated.
+class AIGSimulator // not copyable
+{
+public:
+  enum Kernel
+  {
+    SCALAR,
+    AVX2,
+    AVX512
+  };
+
+  // A node, by where its values and its fanins' values start in sims.
+  // The masks are all ones for complemented fanins.
+  struct Gate
+  {
+    size_t out, in0, in1;
+    uint64_t mask0, mask1;
+    bool exor;
+  };
+
+  // Uses the best kernel the CPU supports.
+  AIGSimulator(Aig_Man_t* p, int words);
+
+  static bool supported(Kernel k);
+  static const char* name(Kernel k);
+
+  Kernel getKernel() const { return kernel; }
+  void setKernel(Kernel k);
+
+  int words() const { return nWords; }
+
+  // Gives every PI random values.
+  void randomize(uint64_t seed);
+
+  // The values of PI i, which can be set before simulate().
+  uint64_t* pi(int i)
+  {
+    return &sims[(size_t)Aig_ManPi(p, i)->Id * nWords];
+  }
+
+  // Evaluates every node from the PIs' values.
+  void simulate();
+
+  // The values of a (not complemented) object, after simulate().
+  const uint64_t* values(const Aig_Obj_t* o) const
+  {
+    return &sims[(size_t)o->Id * nWords];
+  }
+
+private:
+  AIGSimulator(const AIGSimulator&);
+  void operator=(const AIGSimulator&);
+
+  Aig_Man_t* p;
+  const int nWords;
+  Kernel kernel;
+
+  // In topological order.
+  std::vector<Gate> gates;
+  std::vector<uint64_t> sims;
+};
+}
+
+#endif
@@ -0,0 +1,65 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef AIGSWEEPER_H_
+#define AIGSWEEPER_H_
+
+#include "extlib-abc/aig.h"
+#include "stp/STPManager/UserDefinedFlags.h"
+#include "stp/Util/Deadline.h"
+
+namespace stp
+{
+
+// SAT sweeping: nodes of the AIG that random simulation can't tell apart
+// are checked with an incremental SAT solver, and those that are proved
+// equivalent (or complementary) are merged. Each check has a conflict
+// limit and the whole sweep a time limit, after which the nodes left are
+// kept as they are.
+class AIGSweeper // not copyable
+{
+  UserDefinedFlags& uf;
+  Deadline* deadline;
+  int merged;
+
+  AIGSweeper(const AIGSweeper&);
+  void operator=(const AIGSweeper&);
+
+public:
+  AIGSweeper(UserDefinedFlags& _uf, Deadline* _deadline = NULL)
+      : uf(_uf), deadline(_deadline), merged(0)
+  {
+  }
+
+  // Returns a new AIG with the same PIs and POs, in the same order, as p.
+  // p is left as it was.
+  Aig_Man_t* sweep(Aig_Man_t* p);
+
+  // The number of nodes the last sweep merged into others.
+  int getMerged() const { return merged; }
+};
+}
+
+#endif
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #define BBNodeManagerAIG_H_
 
 #include <cstdint>
+#include <unordered_map>
 
 #include "BBNodeAIG.h"
 #include "stp/ToSat/ToSATBase.h"
@@ -51,7 +52,9 @@ public:
   Aig_Man_t* aigMgr;
 
   // Map from symbols to their AIG nodes.
-  typedef std::map<ASTNode, vector<BBNodeAIG>> SymbolToBBNode;
+  typedef std::unordered_map<ASTNode, vector<BBNodeAIG>,
+                             ASTNode::ASTNodeHasher, ASTNode::ASTNodeEqual>
+      SymbolToBBNode;
   SymbolToBBNode symbolToBBNode;
 
   int totalNumberOfNodes()
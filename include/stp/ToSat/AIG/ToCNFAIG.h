@@ -38,22 +38,42 @@ class ASTtoCNF;
 class ToCNFAIG // not copyable
 {
   UserDefinedFlags& uf;
+  Deadline* deadline;
+  int sweep_merged;
+  int rewrite_steps;
+  int rewrite_removed;
 
   void dag_aware_aig_rewrite(
     const bool needAbsRef,
     BBNodeManagerAIG& mgr);
 
+  void sat_sweep(const bool needAbsRef, BBNodeManagerAIG& mgr);
+
   void fill_node_to_var(
     Cnf_Dat_t* cnfData,
     ToSATBase::ASTNodeToSATVar& nodeToVars,
     BBNodeManagerAIG& mgr);
 
 public:
-  ToCNFAIG(UserDefinedFlags& _uf) : uf(_uf) {}
+  ToCNFAIG(UserDefinedFlags& _uf, Deadline* _deadline = NULL)
+      : uf(_uf), deadline(_deadline), sweep_merged(0), rewrite_steps(0),
+        rewrite_removed(0)
+  {
+  }
+
+  // The rewriting steps run in the last toCNF, and the AND nodes that the
+  // steps which made the AIG smaller removed.
+  int getRewriteSteps() const { return rewrite_steps; }
+  int getRewriteRemoved() const { return rewrite_removed; }
+
+  // The number of nodes that SAT sweeping merged in the last toCNF.
+  int getSweepMerged() const { return sweep_merged; }
 
+  // If sink is given the clauses are passed to it as they're derived, and
+  // cnfData is left holding just the variable numbers.
   void toCNF(const BBNodeAIG& top, Cnf_Dat_t*& cnfData,
              ToSATBase::ASTNodeToSATVar& nodeToVars, bool needAbsRef,
-             BBNodeManagerAIG& _mgr);
+             BBNodeManagerAIG& _mgr, Cnf_Sink_t* sink = NULL);
 };
 }
 #endif /* TOCNFAIG_H_ */
@@ -25,10 +25,12 @@ THE SOFTWARE.
 #ifndef TOSATAIG_H
 #define TOSATAIG_H
 #include <cmath>
+#include <memory>
 
 #include "stp/AST/AST.h"
 #include "stp/Util/RunTimes.h"
 #include "stp/STPManager/STPManager.h"
+#include "stp/Simplifier/Simplifier.h"
 #include "stp/ToSat/BitBlaster.h"
 #include "stp/ToSat/AIG/BBNodeManagerAIG.h"
 #include "stp/ToSat/AIG/ToCNFAIG.h"
@@ -45,6 +47,20 @@ private:
 
   ArrayTransformer* arrayTransformer;
 
+  // With refinement, the AIG and the bit-blaster that built it are kept
+  // after the first CNF is made. Later formulas are bit-blasted into the
+  // same AIG, and only the parts that aren't in the solver yet are
+  // converted to CNF.
+  std::unique_ptr<Simplifier> keptSimp;
+  std::unique_ptr<BBNodeManagerAIG> keptMgr;
+  std::unique_ptr<BitBlaster<BBNodeAIG, BBNodeManagerAIG>> keptBB;
+
+  // The SAT variable of the AIG nodes in keptMgr that later formulas can
+  // refer to, by node id. -1 if there isn't one. These are the nodes that
+  // any CNF conversion so far gave a variable, and the inputs. All of
+  // them are frozen.
+  vector<int> aigToSATVar;
+
   // don't assign or copy construct.
   ToSATAIG& operator=(const ToSATAIG& other);
   ToSATAIG(const ToSATAIG& other);
@@ -59,10 +75,21 @@ private:
 
   bool runSolver(SATSolver& satSolver);
   void add_cnf_to_solver(SATSolver& satSolver, Cnf_Dat_t* cnfData);
-  Cnf_Dat_t* bitblast(const ASTNode& input, bool needAbsRef);
+  // If streamTo is given, the clauses go straight into it as they're derived.
+  Cnf_Dat_t* bitblast(const ASTNode& input, bool needAbsRef,
+                      SATSolver* streamTo = NULL);
+
+  // In ToSATAIGParallel.cpp. False if the input doesn't split.
+  bool bitblast_parallel(const ASTNode& input, BBNodeManagerAIG& mgr,
+                         BBNodeAIG& result);
   void handle_cnf_options(Cnf_Dat_t* cnfData, bool needAbsRef);
   void release_cnf_memory(Cnf_Dat_t* cnfData);
 
+  // Converts the part of "input" that isn't in the solver yet to CNF and
+  // adds it. False if "input" is trivially false.
+  bool addFormula(SATSolver& satSolver, const ASTNode& input);
+  void update_node_to_var();
+
   int count;
   bool first;
 
@@ -74,13 +101,14 @@ private:
     first = true;
   }
 
-  static int cnf_calls;
+  // Per thread, like the ABC CNF tables that it governs.
+  static thread_local int cnf_calls;
 
 public:
   bool cbIsDestructed() { return cb == NULL; }
 
   ToSATAIG(STPMgr* bm, ArrayTransformer* at)
-      : ToSATBase(bm), toCNF(bm->UserFlags)
+      : ToSATBase(bm), toCNF(bm->UserFlags, &bm->deadline)
   {
     cb = NULL;
     init();
@@ -89,7 +117,7 @@ public:
 
   ToSATAIG(STPMgr* bm, simplifier::constantBitP::ConstantBitPropagation* cb_,
            ArrayTransformer* at)
-      : ToSATBase(bm), cb(cb_), toCNF(bm->UserFlags)
+      : ToSATBase(bm), cb(cb_), toCNF(bm->UserFlags, &bm->deadline)
   {
     cb = cb_;
     init();
@@ -104,6 +132,8 @@ public:
   ASTNodeToSATVar& SATVar_to_SymbolIndexMap() { return nodeToSATVar; }
 
   bool CallSAT(SATSolver& satSolver, const ASTNode& input, bool needAbsRef);
+
+  bool canAddFormulas() { return keptMgr.get() != NULL; }
 };
 }
 
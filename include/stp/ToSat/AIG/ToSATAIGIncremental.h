@@ -0,0 +1,120 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef TOSATAIGINCREMENTAL_H
+#define TOSATAIGINCREMENTAL_H
+
+#include <memory>
+
+#include "stp/AST/AST.h"
+#include "stp/STPManager/STPManager.h"
+#include "stp/Simplifier/Simplifier.h"
+#include "stp/ToSat/BitBlaster.h"
+#include "stp/ToSat/AIG/BBNodeManagerAIG.h"
+
+namespace stp
+{
+
+// Bit-blasts and encodes into CNF incrementally, so that a sequence of
+// related queries sent to the same SAT solver only pays for the parts of
+// each query that haven't been seen before.
+//
+// The AIG, the bit-blaster's memo tables and the SAT variable of each AIG
+// node live as long as this object. Each AIG node is given the usual
+// three Tseitin clauses the first time it is needed. Those clauses only
+// define the node, they never force it, so the top-level conjuncts of each
+// query are passed to the solver as assumptions instead of being asserted.
+// That way whatever was asserted by an earlier query (or popped since)
+// places no constraint on the next one, and learnt clauses carry over.
+//
+// Array queries need refinement, which adds clauses permanently, so they
+// don't come through here.
+class ToSATAIGIncremental : public ToSATBase
+{
+private:
+  typedef std::unordered_map<ASTNode, unsigned, ASTNode::ASTNodeHasher,
+                             ASTNode::ASTNodeEqual> ASTNodeToWidth;
+
+  ASTNodeToSATVar nodeToSATVar;
+
+  Simplifier simp;
+  std::unique_ptr<BBNodeManagerAIG> mgr;
+  std::unique_ptr<BitBlaster<BBNodeAIG, BBNodeManagerAIG>> bb;
+
+  // The SAT variable for each AIG node, indexed by the node's id. -1 if
+  // the node hasn't been sent to the solver yet.
+  vector<int> aigToSATVar;
+
+  // The solver that holds the clauses for aigToSATVar.
+  SATSolver* solver;
+
+  // The value width of each symbol when it was first bit-blasted. The
+  // parsers reuse a symbol with the same name if it is declared again
+  // after being popped, possibly with a different width.
+  ASTNodeToWidth symbolWidth;
+
+  // Assumed by the next call to CallSAT only.
+  ASTVec assumptions;
+
+  // Indexes into the assumptions of the last call.
+  vector<unsigned> failed;
+
+  // don't assign or copy construct.
+  ToSATAIGIncremental& operator=(const ToSATAIGIncremental& other);
+  ToSATAIGIncremental(const ToSATAIGIncremental& other);
+
+  void reset();
+  bool collectSymbols(const ASTVec& roots, ASTVec& symbols);
+  int getSATVar(SATSolver& satSolver, Aig_Obj_t* n);
+  Minisat::Lit encode(SATSolver& satSolver, Aig_Obj_t* root);
+  void fill_node_to_var(const ASTVec& symbols);
+
+public:
+  ToSATAIGIncremental(STPMgr* bm);
+
+  ~ToSATAIGIncremental();
+
+  // Cleared between queries. The incremental state isn't a table that
+  // anyone else should be clearing.
+  void ClearAllTables() { nodeToSATVar.clear(); }
+
+  // Used to read out the satisfiable answer.
+  ASTNodeToSATVar& SATVar_to_SymbolIndexMap() { return nodeToSATVar; }
+
+  // Must always be called with the same solver.
+  bool CallSAT(SATSolver& satSolver, const ASTNode& input, bool needAbsRef);
+
+  // Formulas that the next call to CallSAT assumes as well as its input.
+  // Unlike the input, the solver reports which of these it needed.
+  void setAssumptions(const ASTVec& a) { assumptions = a; }
+
+  // If the last call to CallSAT was unsatisfiable, the indexes of
+  // assumptions that together with the input were unsatisfiable. Empty if
+  // the input was unsatisfiable on its own.
+  const vector<unsigned>& failedAssumptions() const { return failed; }
+};
+}
+
+#endif
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <cmath>
 #include <cassert>
 #include <map>
+#include <unordered_map>
 #include "stp/STPManager/STPManager.h"
 #include <list>
 #include "stp/Simplifier/constantBitP/MultiplicationStats.h"
@@ -59,14 +60,23 @@ template <class BBNode, class BBNodeManagerT> class BitBlaster // not copyable
   BBNode BBTrue, BBFalse;
 
   // Memo table for bit blasted terms.  If a node has already been
-  // bitblasted, it is mapped to a vector of Boolean formulas for
-  // the
-  std::map<ASTNode, vector<BBNode>> BBTermMemo;
+  // bitblasted, it is mapped to the offset in BBTermBits of the
+  // GetValueWidth() Boolean formulas for its bits. All the terms share
+  // the one pool rather than having a vector each.
+  std::unordered_map<ASTNode, size_t, ASTNode::ASTNodeHasher,
+                     ASTNode::ASTNodeEqual> BBTermMemo;
+  vector<BBNode> BBTermBits;
 
   // Memo table for bit blasted formulas.  If a node has already
   // been bitblasted, it is mapped to a node representing the
   // bitblasted equivalent
-  std::map<ASTNode, BBNode> BBFormMemo;
+  std::unordered_map<ASTNode, BBNode, ASTNode::ASTNodeHasher,
+                     ASTNode::ASTNodeEqual> BBFormMemo;
+
+  // If term is in BBTermMemo, copies its bits to result.
+  bool lookupTerm(const ASTNode& term, vector<BBNode>& result,
+                  set<BBNode>& support);
+  void storeTerm(const ASTNode& term, const vector<BBNode>& bits);
 
   // Get vector of Boolean formulas for sum of two
   // vectors of Boolean formulas
@@ -234,14 +244,15 @@ template <class BBNode, class BBNodeManagerT> class BitBlaster // not copyable
 public:
   simplifier::constantBitP::ConstantBitPropagation* cb;
 
+  // If set, checked for each node that is bit-blasted.
+  Deadline* deadline;
+
   // Bit blast a bitvector term.  The term must have a kind for a
   // bitvector term.  Result is a ref to a vector of formula nodes
   // representing the boolean formula.
   const vector<BBNode> BBTerm(const ASTNode& term, set<BBNode>& support);
-  typename std::map<ASTNode, vector<BBNode>>::iterator simplify_during_bb(
-    ASTNode& term
-    , std::set<BBNode>& support
-  );
+  bool simplify_during_bb(ASTNode& term, std::set<BBNode>& support,
+                          vector<BBNode>& result);
 
   BitBlaster(BBNodeManagerT* bnm, Simplifier* _simp, NodeFactory* astNodeF,
              UserDefinedFlags* _uf,
@@ -254,10 +265,11 @@ public:
     bbbvle_variant(false),
     upper_multiplication_bound(false),
     bvplus_variant(true),
-    multiplication_variant("7")
+    multiplication_variant(_uf->multiplication_variant)
   {
     nf = bnm;
     cb = cb_;
+    deadline = NULL;
     BBTrue = nf->getTrue();
     BBFalse = nf->getFalse();
     simp = _simp;
@@ -267,6 +279,7 @@ public:
   void ClearAllTables()
   {
     BBTermMemo.clear();
+    BBTermBits.clear();
     BBFormMemo.clear();
   }
 
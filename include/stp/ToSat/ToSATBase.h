@@ -59,6 +59,11 @@ public:
   virtual bool CallSAT(SATSolver& SatSolver, const ASTNode& input,
                        bool doesAbsRef) = 0;
 
+  // Whether calls to CallSAT after the first may be given a formula, which
+  // is added to what the solver already has. Otherwise they're given
+  // ASTTrue, and anything more has to be added to the solver directly.
+  virtual bool canAddFormulas() { return false; }
+
   virtual ASTNodeToSATVar& SATVar_to_SymbolIndexMap() = 0;
 
   virtual void ClearAllTables(void) = 0;
@@ -0,0 +1,131 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef DEADLINE_H_
+#define DEADLINE_H_
+
+#include <cassert>
+#include <climits>
+#include <sys/time.h>
+
+namespace stp
+{
+
+// Thrown out of the simplifier, the bit-blaster and the CNF generator once
+// the deadline for the query has passed.
+class DeadlineExpired
+{
+};
+
+// Lets another thread stop a query early, e.g. once a portfolio run has
+// its answer. requested() is polled wherever the deadline is checked.
+class Cancellation
+{
+public:
+  virtual ~Cancellation() {}
+  virtual bool requested() const = 0;
+};
+
+// The wall-clock time by which the query being solved has to be answered.
+// Unlike the conflict budget, it covers all of the work done for a query,
+// not just the SAT solver's part.
+class Deadline
+{
+  // Milliseconds since the epoch, -1 if there's no deadline.
+  long end;
+
+  // Not owned, NULL if the query can't be cancelled.
+  const Cancellation* cancellation;
+
+  // Calls to check() since the clock was last read.
+  unsigned calls;
+
+  enum
+  {
+    CALLS_PER_CLOCK_READ = 64
+  };
+
+public:
+  Deadline() : end(-1), cancellation(NULL), calls(0) {}
+
+  static long now()
+  {
+    timeval t;
+    gettimeofday(&t, NULL);
+    return (1000 * t.tv_sec) + (t.tv_usec / 1000);
+  }
+
+  // A negative time means no deadline.
+  void set(long milliseconds)
+  {
+    end = (milliseconds < 0) ? -1 : now() + milliseconds;
+    calls = 0;
+  }
+
+  void clear() { end = -1; }
+
+  // Survives set() and clear(), which are per query.
+  void setCancellation(const Cancellation* c) { cancellation = c; }
+
+  bool isSet() const { return end != -1 || cancellation != NULL; }
+
+  bool expired() const
+  {
+    if (cancellation != NULL && cancellation->requested())
+      return true;
+    return end != -1 && now() >= end;
+  }
+
+  // A cancellable query without a time limit has as long as it likes.
+  long remaining() const
+  {
+    assert(isSet());
+    if (end == -1)
+      return LONG_MAX;
+    const long r = end - now();
+    return (r < 0) ? 0 : r;
+  }
+
+  // Cheap enough to call for each node visited, it only reads the clock
+  // every so often.
+  void check()
+  {
+    if (!isSet() || ++calls < CALLS_PER_CLOCK_READ)
+      return;
+    calls = 0;
+    if (expired())
+      throw DeadlineExpired();
+  }
+
+  // For between steps that each take a while.
+  void checkNow()
+  {
+    if (expired())
+      throw DeadlineExpired();
+  }
+};
+}
+
+#endif
@@ -0,0 +1,74 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef MAPPEDINPUT_H
+#define MAPPEDINPUT_H
+
+#include <cstddef>
+#include <vector>
+
+namespace stp
+{
+
+// A whole input file in memory, laid out the way flex's yy_scan_buffer
+// wants it: the text followed by two NUL bytes, in memory the lexer may
+// write to. Where mmap is available a regular file is mapped privately
+// rather than read, so the lexers work over the page cache with no copy.
+// Flex temporarily writes a NUL after each token, so the pages it
+// touches are copied on write; the file itself is never changed.
+// Anything that can't be mapped (pipes, terminals) is read into memory.
+// not copyable
+class MappedInput
+{
+public:
+  MappedInput();
+  ~MappedInput();
+
+  // Returns false if the file can't be opened or read.
+  bool open(const char* path);
+  void close();
+
+  // The text, followed by two NUL bytes.
+  char* buffer() { return data; }
+  // Length of the text, not counting the two NUL bytes.
+  size_t size() const { return length; }
+  bool isMapped() const { return mapped_length != 0; }
+
+private:
+  MappedInput(const MappedInput&);
+  MappedInput& operator=(const MappedInput&);
+
+  bool map(int fd, size_t size);
+  bool readAll(int fd);
+
+  char* data;
+  size_t length;
+  size_t mapped_length;
+  std::vector<char> copy;
+};
+
+} // end namespace stp
+
+#endif
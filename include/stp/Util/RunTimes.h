@@ -57,7 +57,17 @@ public:
     UseITEContext,
     AIGSimplifyCore,
     IntervalPropagation,
-    AlwaysTrue
+    AlwaysTrue,
+    QueryCacheHit,
+    QueryCacheMiss,
+    ModelReuseHit,
+    ModelReuseMiss,
+    UnsatCoreHit,
+    UnsatCoreMiss,
+    QueryCacheFileHit,
+    AIGSweepMerge,
+    AIGRewriteStep,
+    AIGRewriteRemoved
   };
 
   static std::string CategoryNames[];
@@ -80,10 +90,21 @@ private:
 
 public:
   DLL_PUBLIC void addCount(Category c);
+  // Counts c n times over.
+  DLL_PUBLIC void addCount(Category c, int n);
+  // How many times c has been counted since the last clear().
+  DLL_PUBLIC int getCount(Category c) const;
   DLL_PUBLIC void start(Category c);
   DLL_PUBLIC void stop(Category c);
   DLL_PUBLIC void print();
 
+  // How many categories are being timed right now.
+  size_t depth() const { return category_stack.size(); }
+
+  // Stops the categories started since the stack was "depth" deep, for
+  // when an exception skipped their stop()s.
+  DLL_PUBLIC void unwind(size_t depth);
+
   std::string getDifference();
 
   void resetDifference() { getDifference(); }
@@ -0,0 +1,113 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef SLABALLOCATOR_H_
+#define SLABALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace stp
+{
+
+// Hands out fixed-size blocks carved from large slabs. Released blocks are
+// kept on a free list and reused; the slabs themselves only go back to the
+// system when the allocator is destroyed. Not thread-safe, each node
+// manager has its own.
+template <size_t BlockSize> class SlabAllocator
+{
+  union Block
+  {
+    Block* next;
+    typename std::aligned_storage<BlockSize, alignof(std::max_align_t)>::type
+        storage;
+  };
+
+  static const size_t slab_bytes = 64 * 1024;
+  static const size_t blocks_per_slab =
+      sizeof(Block) < slab_bytes ? slab_bytes / sizeof(Block) : 1;
+
+  std::vector<Block*> slabs;
+  Block* free_list;
+
+  // Blocks of the last slab that haven't been handed out yet.
+  size_t next_in_slab;
+
+  size_t in_use;
+
+public:
+  SlabAllocator() : free_list(NULL), next_in_slab(blocks_per_slab), in_use(0)
+  {
+  }
+
+  ~SlabAllocator()
+  {
+    for (size_t i = 0; i < slabs.size(); i++)
+      ::operator delete(slabs[i]);
+  }
+
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  void* allocate()
+  {
+    in_use++;
+    if (free_list != NULL)
+    {
+      Block* b = free_list;
+      free_list = b->next;
+      return b;
+    }
+
+    if (next_in_slab == blocks_per_slab)
+    {
+      slabs.push_back(
+          static_cast<Block*>(::operator new(blocks_per_slab * sizeof(Block))));
+      next_in_slab = 0;
+    }
+    return &slabs.back()[next_in_slab++];
+  }
+
+  void release(void* p)
+  {
+    in_use--;
+    Block* b = static_cast<Block*>(p);
+    b->next = free_list;
+    free_list = b;
+  }
+
+  size_t blocksInUse() const { return in_use; }
+
+  size_t bytesReserved() const
+  {
+    return slabs.size() * blocks_per_slab * sizeof(Block);
+  }
+};
+
+} // end of namespace
+
+#endif
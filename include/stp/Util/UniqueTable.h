@@ -0,0 +1,222 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#ifndef UNIQUETABLE_H_
+#define UNIQUETABLE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace stp
+{
+
+// Set of node pointers used for hash-consing. Open addressing with Robin
+// Hood probing, so a lookup walks a short run of adjacent slots instead of
+// a bucket list, and inserting doesn't allocate. Each slot caches the
+// node's hash so that probing and growing don't have to rehash the node.
+//
+// Only the parts of std::unordered_set that STPMgr uses are provided.
+// Iterators are invalidated by insert and erase.
+template <class T, class Hasher, class Equal> class UniqueTable
+{
+  struct Slot
+  {
+    T* ptr;
+    size_t hash;
+  };
+
+  std::vector<Slot> slots;
+  size_t count;
+  size_t mask;
+
+  size_t distance(size_t i) const { return (i - slots[i].hash) & mask; }
+
+  // Places n, which mustn't already be present. Returns its slot.
+  size_t place(T* n, size_t h)
+  {
+    Slot carry = {n, h};
+    size_t i = h & mask;
+    size_t d = 0;
+    size_t result = slots.size();
+    while (true)
+    {
+      if (slots[i].ptr == NULL)
+      {
+        slots[i] = carry;
+        return result == slots.size() ? i : result;
+      }
+      size_t existing = distance(i);
+      if (existing < d)
+      {
+        // Take the slot from the entry that's closer to its home.
+        std::swap(carry, slots[i]);
+        if (result == slots.size())
+          result = i;
+        d = existing;
+      }
+      i = (i + 1) & mask;
+      d++;
+    }
+  }
+
+  void grow()
+  {
+    std::vector<Slot> old;
+    old.swap(slots);
+    Slot empty = {NULL, 0};
+    slots.assign(old.empty() ? 64 : old.size() * 2, empty);
+    mask = slots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++)
+      if (old[i].ptr != NULL)
+        place(old[i].ptr, old[i].hash);
+  }
+
+  size_t lookup(const T* key, size_t h) const
+  {
+    if (slots.empty())
+      return slots.size();
+
+    Equal equal;
+    size_t i = h & mask;
+    for (size_t d = 0;; d++)
+    {
+      const Slot& s = slots[i];
+      if (s.ptr == NULL || distance(i) < d)
+        return slots.size();
+      if (s.hash == h && equal(s.ptr, key))
+        return i;
+      i = (i + 1) & mask;
+    }
+  }
+
+public:
+  class iterator
+  {
+    friend class UniqueTable;
+    const std::vector<Slot>* slots;
+    size_t i;
+
+    iterator(const std::vector<Slot>* s, size_t index) : slots(s), i(index)
+    {
+      skip();
+    }
+
+    void skip()
+    {
+      while (i < slots->size() && (*slots)[i].ptr == NULL)
+        i++;
+    }
+
+  public:
+    iterator() : slots(NULL), i(0) {}
+
+    T* operator*() const { return (*slots)[i].ptr; }
+
+    iterator& operator++()
+    {
+      i++;
+      skip();
+      return *this;
+    }
+
+    iterator operator++(int)
+    {
+      iterator r = *this;
+      ++*this;
+      return r;
+    }
+
+    bool operator==(const iterator& o) const { return i == o.i; }
+    bool operator!=(const iterator& o) const { return i != o.i; }
+  };
+  typedef iterator const_iterator;
+
+  UniqueTable() : count(0), mask(0) {}
+
+  iterator begin() const { return iterator(&slots, 0); }
+  iterator end() const { return iterator(&slots, slots.size()); }
+
+  size_t size() const { return count; }
+
+  iterator find(const T* key) const
+  {
+    return iterator(&slots, lookup(key, Hasher()(key)));
+  }
+
+  std::pair<iterator, bool> insert(T* n)
+  {
+    const size_t h = Hasher()(n);
+    size_t i = lookup(n, h);
+    if (i != slots.size())
+      return std::make_pair(iterator(&slots, i), false);
+
+    // Keep the load factor below 7/8, Robin Hood probing keeps the runs
+    // short up to there.
+    if ((count + 1) * 8 > slots.size() * 7)
+      grow();
+
+    count++;
+    return std::make_pair(iterator(&slots, place(n, h)), true);
+  }
+
+  // Removes exactly this node, not just one equal to it.
+  void erase(T* n)
+  {
+    if (slots.empty())
+      return;
+
+    size_t i = Hasher()(n) & mask;
+    while (slots[i].ptr != n)
+    {
+      if (slots[i].ptr == NULL)
+        return;
+      i = (i + 1) & mask;
+    }
+
+    // Shift the rest of the run back a slot, so no tombstone is needed.
+    size_t next = (i + 1) & mask;
+    while (slots[next].ptr != NULL && distance(next) != 0)
+    {
+      slots[i] = slots[next];
+      i = next;
+      next = (next + 1) & mask;
+    }
+    slots[i].ptr = NULL;
+    count--;
+  }
+
+  void clear()
+  {
+    slots.clear();
+    count = 0;
+    mask = 0;
+  }
+};
+
+} // end of namespace
+
+#endif
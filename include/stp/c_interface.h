@@ -164,7 +164,89 @@ enum ifaceflag_t
   //! 
   //! Currently simply forwards to MS.
   //! 
-  MSP
+  MSP,
+
+  //! \brief Keep the SAT solver between queries when param_value is non-zero.
+  //! 
+  //! Learnt clauses and the bit-blasted form of the expressions that were
+  //! already asserted are then reused by later queries. Queries with
+  //! arrays are still solved from scratch.
+  //! 
+  INCREMENTAL,
+
+  //! \brief Race param_value differently configured solvers on each query.
+  //! 
+  //! Each runs on its own thread with its own copy of the query, and the
+  //! first definite answer is taken. 0 or 1 turns the portfolio off. It
+  //! isn't used when solving incrementally.
+  //! 
+  PORTFOLIO,
+
+  //! \brief Bit-blast with up to param_value threads.
+  //! 
+  //! A top-level conjunction is split into groups that share as few
+  //! symbols as possible, and each group is bit-blasted on its own
+  //! thread. 0 or 1 bit-blasts on the calling thread.
+  //! 
+  BITBLAST_THREADS,
+
+  //! \brief Remember the answers to the last param_value queries.
+  //! 
+  //! A query that is the same as one of them, up to the names of its
+  //! symbols, is answered without solving, along with its counterexample.
+  //! Queries containing arrays aren't cached. 0 turns the cache off.
+  //! 
+  QUERY_CACHE,
+
+  //! \brief Solve the independent parts of each query separately.
+  //! 
+  //! The conjuncts of the asserts and the negated query are grouped so
+  //! that no symbol is in two groups, and each group is solved on its
+  //! own, the query's first. With QUERY_CACHE set, groups that haven't
+  //! changed since an earlier query are answered from the cache. Queries
+  //! containing arrays aren't split. 0 turns it off.
+  //! 
+  INDEPENDENCE_SLICING,
+
+  //! \brief Keep the models of the last param_value satisfiable queries.
+  //! 
+  //! Each query is first evaluated under them, and if one satisfies it,
+  //! the query is answered with that model without bit-blasting. Queries
+  //! containing arrays don't use them. 0 turns it off.
+  //! 
+  MODEL_REUSE,
+
+  //! \brief Keep the unsatisfiable cores of the last param_value valid
+  //! queries.
+  //! 
+  //! The asserts and the negated query are split into their top-level
+  //! conjuncts, which are solved as assumptions on an incremental solver.
+  //! When the query is valid, the conjuncts that were needed are kept, and
+  //! a later query that has all of them is valid without solving. As
+  //! with incremental solving, the simplifications that need the whole
+  //! input are skipped, so a query that doesn't hit a core may take longer
+  //! than it would otherwise. Queries containing arrays don't use it. 0
+  //! turns it off.
+  //! 
+  UNSAT_CORE_CACHE,
+
+  //! \brief Merge equivalent nodes of the bit-blasted circuit when
+  //! param_value is non-zero.
+  //! 
+  //! Nodes that random simulation can't tell apart are checked with a SAT
+  //! solver before the circuit is converted to CNF, and merged if they're
+  //! equivalent. Queries containing arrays aren't swept.
+  //! 
+  AIG_SWEEP,
+
+  //! \brief Rewrite the bit-blasted circuit with ABC before it's converted
+  //! to CNF when param_value is non-zero, as --aig-rewrite does.
+  //! 
+  //! The steps are the default script, "rw,rf,b,rw", unless they're set
+  //! with vc_setAIGRewriteScript. Queries containing arrays aren't
+  //! rewritten.
+  //! 
+  AIG_REWRITE
 
 };
 
@@ -175,6 +257,67 @@ enum ifaceflag_t
 //! 
 DLL_PUBLIC void vc_setInterfaceFlags(VC vc, enum ifaceflag_t f, int param_value);
 
+//! Counts of what the validity checker has done, for vc_getStatistic.
+//! 
+enum statistic_t
+{
+  //! Queries answered from the in-memory query cache (QUERY_CACHE) or the
+  //! query cache file.
+  //! 
+  QUERY_CACHE_HITS,
+
+  //! Queries looked up in a query cache and not found.
+  //! 
+  QUERY_CACHE_MISSES,
+
+  //! Those of QUERY_CACHE_HITS that were answered from the query cache
+  //! file, having been found there and not in memory.
+  //! 
+  QUERY_CACHE_FILE_HITS,
+
+  //! Queries satisfied by a model kept from an earlier one (MODEL_REUSE).
+  //! 
+  MODEL_REUSE_HITS,
+
+  //! Queries that none of the kept models satisfied.
+  //! 
+  MODEL_REUSE_MISSES,
+
+  //! Nodes of the bit-blasted circuit that SAT sweeping (AIG_SWEEP) merged
+  //! into equivalent ones.
+  //! 
+  AIG_SWEEP_MERGES,
+
+  //! Steps of the AIG rewriting script (AIG_REWRITE) that have been run.
+  //! Steps skipped because the circuit was too big aren't counted.
+  //! 
+  AIG_REWRITE_STEPS,
+
+  //! AND nodes removed by the rewriting steps that made the circuit
+  //! smaller.
+  //! 
+  AIG_REWRITE_NODES_REMOVED
+};
+
+//! \brief Returns the given count, since the validity checker was created.
+//! 
+DLL_PUBLIC long vc_getStatistic(VC vc, enum statistic_t s);
+
+//! \brief Keep the answers to queries in the file at the given path.
+//! 
+//! The file is created if it doesn't exist, and may be shared by any
+//! number of processes on the same machine. A query that is the same as
+//! one already in the file, up to the names of its symbols, is answered
+//! without solving. NULL or "" stops using the file.
+//! 
+DLL_PUBLIC void vc_setQueryCacheFile(VC vc, const char* path);
+
+//! \brief Set the steps AIG_REWRITE runs, as --aig-rewrite-script does.
+//! 
+//! The steps are comma separated: "rw" rewrites, "rf" refactors and "b"
+//! balances. Returns 0, and keeps the steps it had, if one isn't known.
+DLL_PUBLIC int vc_setAIGRewriteScript(VC vc, const char* script);
+
 //! \brief Deprecated: this functionality is no longer needed!
 //! 
 //! Since recent versions of STP division is always total.
@@ -380,6 +523,23 @@ DLL_PUBLIC void vc_printExprFile(VC vc, Expr e, int fd);
 //! It is the responsibility of the caller to free the memory afterwards.
 DLL_PUBLIC void vc_printExprToBuffer(VC vc, Expr e, char** buf, unsigned long* len);
 
+//! \brief Writes the given expression into a buffer allocated by STP, in a
+//!        compact binary form that vc_deserializeExpr reads back without
+//!        parsing.
+//!
+//! The buffer is returned via output parameter 'buf' alongside its length 'len'.
+//! It is the responsibility of the caller to free the memory afterwards.
+//! The format depends on the STP version, so it is for passing expressions
+//! between processes and caching them, not for long-term storage.
+DLL_PUBLIC void vc_serializeExpr(VC vc, Expr e, char** buf, unsigned long* len);
+
+//! \brief Reads back an expression written by vc_serializeExpr, possibly by
+//!        another validity checker or process.
+//!
+//! Variables are matched by name, and are created if they don't exist yet.
+//! The expression is rebuilt without simplification.
+DLL_PUBLIC Expr vc_deserializeExpr(VC vc, const char* buf, unsigned long len);
+
 //! \brief Prints the counter example after an invalid query to stdout.
 //! 
 //! This method should only be called after a query which returns false.
@@ -458,11 +618,12 @@ DLL_PUBLIC Expr vc_simplify(VC vc, Expr e);
 //!   2: if errors occured
 //!   3: if the timeout was reached
 //! 
-//! Note: The given timeout is a soft timeout. Use the flag '-g' for a hard timeout
-//!       that will abort automatically. Soft timeouts are only checked sparingly,
-//!       so the actual timeout may be larger.
+//! Note: The timeout is wall-clock time, and covers simplifying, bit-blasting
+//!       and CNF generation as well as SAT solving. It is checked often,
+//!       but not continuously, so the query may run a little longer.
+//!       A negative timeout means no limit.
 //! 
-//! Note: The cryptominisat solver does not check the timeout, yet!
+//! Note: The cryptominisat solver measures the time it has left as CPU time.
 //! 
 DLL_PUBLIC int vc_query_with_timeout(VC vc, Expr e, int timeout_ms);
 
@@ -476,6 +637,34 @@ DLL_PUBLIC int vc_query_with_timeout(VC vc, Expr e, int timeout_ms);
 //! 
 DLL_PUBLIC int vc_query(VC vc, Expr e);
 
+//! \brief Checks whether the current assertions and all of the given
+//!        assumptions can hold together.
+//! 
+//! The assumptions aren't asserted, they only hold for this call. The SAT
+//! solver is kept between calls, so checking many different assumptions
+//! this way is much cheaper than push, assert, query and pop.
+//! 
+//! Returns ...
+//!   0: if they can all hold (the counter example is a model of them)
+//!   1: if they can't (see 'vc_getFailedAssumptions')
+//!   2: if errors occured
+//!   3: if the timeout was reached
+//! 
+DLL_PUBLIC int vc_queryWithAssumptions(VC vc, Expr* assumptions,
+                                       int numAssumptions);
+
+//! \brief Returns the assumptions that the last call to
+//!        'vc_queryWithAssumptions' needed to show that it couldn't hold.
+//! 
+//! The buffer for the assumptions is allocated by STP and returned via the
+//! non-null expected out parameters 'outFailed' and 'outSize'. The size is
+//! zero if the assertions can't hold whatever is assumed.
+//! 
+//! It is the caller's responsibility to free the memory afterwards.
+//! 
+DLL_PUBLIC void vc_getFailedAssumptions(VC vc, Expr** outFailed,
+                                        int* outSize);
+
 //! \brief Returns the counter example after an invalid query.
 //! 
 DLL_PUBLIC Expr vc_getCounterExample(VC vc, Expr e);
@@ -1114,6 +1303,18 @@ DLL_PUBLIC int getExprID(Expr ex);
 //! 
 DLL_PUBLIC int vc_parseMemExpr(VC vc, const char* s, Expr* outQuery, Expr* outAsserts);
 
+//! \brief Like vc_parseMemExpr, but lexes the input in place instead of
+//!        copying it first.
+//! 
+//! 'buffer' must hold 'length' bytes of input followed by two NUL bytes.
+//! The lexer writes to the buffer while parsing, but leaves it as it was
+//! once this returns.
+//! 
+//! Returns '1' if parsing was successful.
+//! 
+DLL_PUBLIC int vc_parseMemBuffer(VC vc, char* buffer, unsigned long length,
+                                 Expr* outQuery, Expr* outAsserts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,11 @@ class LETMgr;
 class Cpp_interface
 {
   STPMgr& bm;
+
+  // The solver used by checkSat and friends. The one-argument constructor
+  // creates it; otherwise it's the STP current on the constructing thread.
+  STP* solver;
+
   bool alreadyWarned;
   bool print_success;
   bool ignoreCheckSatRequest;
@@ -186,7 +191,7 @@ public:
 
 // Functions used by C++ clients of STP. TODO: either export abc cleanly or don't use this in clients.
 
-/// Export version of Cnf_ClearMemory.
+/// Export version of Cnf_ClearMemory. Frees the calling thread's tables.
 DLL_PUBLIC void CNFClearMemory();
 }
 
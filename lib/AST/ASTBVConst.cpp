@@ -40,8 +40,11 @@ ASTBVConst::ASTBVConst(const ASTBVConst& sym) : ASTInternal(sym.nodeManager, sym
 // unique table
 void ASTBVConst::CleanUp()
 {
-  nodeManager->_bvconst_unique_table.erase(this);
-  delete this;
+  STPMgr* mgr = nodeManager;
+  mgr->_bvconst_unique_table.erase(this);
+  mgr->ReleaseNodeIndex(node_index);
+  this->~ASTBVConst();
+  mgr->bvconst_arena.release(this);
 } 
 
 // Print function for bvconst -- return _bvconst value in bin
@@ -34,8 +34,11 @@ namespace stp
 // the unique table
 void ASTInterior::CleanUp()
 {
-  nodeManager->_interior_unique_table.erase(this);
-  delete this;
+  STPMgr* mgr = nodeManager;
+  mgr->_interior_unique_table.erase(this);
+  mgr->ReleaseNodeIndex(node_index);
+  this->~ASTInterior();
+  mgr->interior_arena.release(this);
 } 
 
 // Returns kinds.  "lispprinter" handles printing of parenthesis
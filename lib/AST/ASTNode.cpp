@@ -130,6 +130,11 @@ unsigned ASTNode::GetNodeNum() const
   return _int_node_ptr->GetNodeNum();
 }
 
+uint32_t ASTNode::GetNodeIndex() const
+{
+  return _int_node_ptr->node_index;
+}
+
 unsigned int ASTNode::GetIndexWidth() const
 {
   return _int_node_ptr->getIndexWidth();
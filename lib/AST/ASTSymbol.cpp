@@ -46,9 +46,12 @@ void ASTSymbol::nodeprint(ostream& os, bool /*c_friendly*/)
 // unique table
 void ASTSymbol::CleanUp()
 {
-  nodeManager->_symbol_unique_table.erase(this);
+  STPMgr* mgr = nodeManager;
+  mgr->_symbol_unique_table.erase(this);
+  mgr->ReleaseNodeIndex(node_index);
   free((char*)this->_name);
-  delete this;
+  this->~ASTSymbol();
+  mgr->symbol_arena.release(this);
 }
 
 } // end of namespace
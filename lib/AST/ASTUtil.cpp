@@ -51,7 +51,7 @@ ostream& operator<<(ostream& os, const Spacer& sp)
 // the function will then print the stats that it has collected.
 void CountersAndStats(const char* functionname, STPMgr* bm)
 {
-  static function_counters s;
+  static thread_local function_counters s;
   if (bm->UserFlags.stats_flag)
   {
 
@@ -39,7 +39,11 @@ using std::cout;
 using std::cerr;
 using std::endl;
 
-uint64_t ASTInternal::node_uid_cntr = 0;
+ASTInternal::ASTInternal(STPMgr* mgr, Kind kind)
+    : nodeManager(mgr), node_uid(mgr->node_uid_cntr += 2), _ref_count(0),
+      node_index(0), _kind(kind), iteration(0)
+{
+}
 
 /****************************************************************
  * Universal Helper Functions                                   *
@@ -26,5 +26,5 @@ THE SOFTWARE.
 namespace stp
 {
 
-vector<MutableASTNode*> MutableASTNode::all;
+thread_local vector<MutableASTNode*> MutableASTNode::all;
 }
@@ -52,8 +52,8 @@ ASTNode HashingNodeFactory::CreateNode(const Kind kind,
     SortByArith(children);
   }
 
-  ASTInterior* n_ptr = new ASTInterior(&bm, kind, children);
-  ASTNode n(bm.LookupOrCreateInterior(n_ptr));
+  ASTInterior key(&bm, kind, std::move(children));
+  ASTNode n(bm.LookupOrCreateInterior(key));
   return n;
 }
 
@@ -97,6 +97,8 @@ sub gen_h_file {
 
   print HFILE
     "} Kind;\n\n",
+    "// The number of kinds. Every Kind is less than this.\n",
+    "const int KIND_COUNT = ", scalar(@kindnames), ";\n\n",
     "extern unsigned char _kind_categories[];\n\n";
 
   # For category named "cat", generate functions "bool is_cat_kind(k);"
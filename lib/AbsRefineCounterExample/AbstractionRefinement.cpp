@@ -239,6 +239,39 @@ void applyAxiomsToSolver(ToSATBase::ASTNodeToSATVar& satVar,
   toBe.clear();
 }
 
+// If tosat can take formulas after its first call, the axioms are returned
+// as one, so they're converted to CNF the same way as the rest of the
+// problem. Otherwise clauses for them are added to the solver directly, and
+// ASTTrue is returned.
+ASTNode applyAxioms(STPMgr* bm, Simplifier* simp, ToSATBase* tosat,
+                    vector<AxiomToBe>& toBe, SATSolver& SatSolver)
+{
+  if (!tosat->canAddFormulas())
+  {
+    applyAxiomsToSolver(tosat->SATVar_to_SymbolIndexMap(), toBe, SatSolver);
+    return bm->ASTTrue;
+  }
+
+  ASTVec axioms;
+  for (size_t i = 0; i < toBe.size(); i++)
+  {
+    const ASTNode index =
+        simp->CreateSimplifiedEQ(toBe[i].index0, toBe[i].index1);
+    const ASTNode value =
+        simp->CreateSimplifiedEQ(toBe[i].value0, toBe[i].value1);
+    if (index == bm->ASTFalse || value == bm->ASTTrue)
+      continue;
+    axioms.push_back(bm->CreateNode(IMPLIES, index, value));
+  }
+  toBe.clear();
+
+  if (axioms.empty())
+    return bm->ASTTrue;
+  if (axioms.size() == 1)
+    return axioms[0];
+  return bm->CreateNode(AND, axioms);
+}
+
 bool sortBySize(const pair<ASTNode, ArrayTransformer::arrTypeMap>& a,
                 const pair<ASTNode, ArrayTransformer::arrTypeMap>& b)
 {
@@ -374,12 +407,12 @@ AbsRefine_CounterExample::SATBased_ArrayReadRefinement(
       }
       if (FalseAxiomsVec.size() > 0)
       {
-        ToSATBase::ASTNodeToSATVar& satVar = tosat->SATVar_to_SymbolIndexMap();
-        applyAxiomsToSolver(satVar, FalseAxiomsVec, SatSolver);
+        const ASTNode axioms =
+            applyAxioms(bm, simp, tosat, FalseAxiomsVec, SatSolver);
 
         SOLVER_RETURN_TYPE res2;
         bm->GetRunTimes()->stop(RunTimes::ArrayReadRefinement);
-        res2 = CallSAT_ResultCheck(SatSolver, ASTTrue, original_input, tosat,
+        res2 = CallSAT_ResultCheck(SatSolver, axioms, original_input, tosat,
                                    true);
 
         if (SOLVER_UNDECIDED != res2)
@@ -396,11 +429,11 @@ AbsRefine_CounterExample::SATBased_ArrayReadRefinement(
       std::cout << "Adding all the remaining " << RemainingAxiomsVec.size()
                 << " read axioms " << std::endl;
     }
-    ToSATBase::ASTNodeToSATVar& satVar = tosat->SATVar_to_SymbolIndexMap();
-    applyAxiomsToSolver(satVar, RemainingAxiomsVec, SatSolver);
+    const ASTNode axioms =
+        applyAxioms(bm, simp, tosat, RemainingAxiomsVec, SatSolver);
 
     bm->GetRunTimes()->stop(RunTimes::ArrayReadRefinement);
-    return CallSAT_ResultCheck(SatSolver, ASTTrue, original_input, tosat, true);
+    return CallSAT_ResultCheck(SatSolver, axioms, original_input, tosat, true);
   }
 // For difficult problems, I suspec this is a better way to do it.
 // However because it can cause an extra three SAT solver calls, it slows down
@@ -34,14 +34,17 @@ THE SOFTWARE.
 
 namespace stp
 {
-enum inputStatus input_status = NOT_DECLARED;
+thread_local enum inputStatus input_status = NOT_DECLARED;
 
 // Originally just used by the parser, now used elesewhere.
-STP* GlobalSTP;
-STPMgr* GlobalParserBM;
+thread_local STP* GlobalSTP;
+thread_local STPMgr* GlobalParserBM;
 
 // Used exclusively for parsing.
-Cpp_interface* GlobalParserInterface;
+thread_local Cpp_interface* GlobalParserInterface;
+
+// Held for the duration of a cvc/smt/smt2 parse.
+std::mutex GlobalParserMutex;
 
 // FIXME: This isn't in Globals.h so how can anyone use this?
 void (*vc_error_hdlr)(const char* err_msg) = 0;
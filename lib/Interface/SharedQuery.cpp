@@ -0,0 +1,412 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/Interface/SharedQuery.h"
+#include "stp/AST/NodeFactory/HashingNodeFactory.h"
+#include "stp/AbsRefineCounterExample/AbsRefine_CounterExample.h"
+#include "stp/Parser/BinaryReader.h"
+#include "stp/Printer/printers.h"
+#include "stp/STPManager/STP.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stp
+{
+#if !defined(_MSC_VER)
+
+namespace
+{
+const char MAGIC[4] = {'S', 'T', 'P', 'Q'};
+const uint32_t VERSION = 2;
+
+// How often a producer waiting for an answer checks that the worker is
+// still there.
+const long LIVENESS_CHECK_MS = 100;
+
+void semWait(sem_t* s)
+{
+  while (sem_wait(s) != 0)
+    if (errno != EINTR)
+      FatalError("SharedQuery: sem_wait failed");
+}
+
+// The query's bit-vector and boolean variables, each equal to its value
+// in the counterexample.
+ASTNode buildModel(STP* stp, const ASTNode& query)
+{
+  STPMgr* bm = stp->bm;
+  NodeFactory* nf = bm->hashingNodeFactory;
+
+  ASTVec model;
+  ASTNodeSet visited;
+  ASTVec stack;
+  stack.push_back(query);
+  while (!stack.empty())
+  {
+    const ASTNode n = stack.back();
+    stack.pop_back();
+    if (!visited.insert(n).second)
+      continue;
+
+    if (n.GetKind() == SYMBOL)
+    {
+      if (n.GetIndexWidth() > 0)
+        continue;
+      ASTNode value = stp->Ctr_Example->GetCounterExample(n);
+      if (value.GetKind() == TRUE || value.GetKind() == FALSE)
+        model.push_back(nf->CreateNode(IFF, n, value));
+      else if (value.GetKind() == BVCONST)
+        model.push_back(nf->CreateNode(EQ, n, value));
+      continue;
+    }
+
+    for (size_t i = 0; i < n.Degree(); i++)
+      stack.push_back(n[i]);
+  }
+
+  if (model.empty())
+    return bm->ASTTrue;
+  if (model.size() == 1)
+    return model[0];
+  return nf->CreateNode(AND, model);
+}
+}
+
+struct SharedQueryHeader
+{
+  char magic[4];
+  uint32_t version;
+  uint64_t capacity;
+  sem_t request;
+  sem_t response;
+  uint64_t length; // Of the query, or of the model once answered.
+  int32_t result;
+  uint32_t shutdown;
+
+  // Held by the worker while it serves. It's robust, so it's let go when
+  // the worker dies, however it dies.
+  pthread_mutex_t worker;
+  // Set once a worker has taken the lock.
+  uint32_t served;
+};
+
+SharedQuery::SharedQuery()
+    : header(NULL), mapped_length(0), data_capacity(0)
+{
+}
+
+SharedQuery::~SharedQuery()
+{
+  close();
+}
+
+bool SharedQuery::create(const char* name, size_t capacity)
+{
+  close();
+
+  const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+    return false;
+
+  const size_t length = sizeof(SharedQueryHeader) + capacity;
+  void* region = MAP_FAILED;
+  if (ftruncate(fd, length) == 0)
+    region =
+        mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (region == MAP_FAILED)
+  {
+    shm_unlink(name);
+    return false;
+  }
+
+  header = (SharedQueryHeader*)region;
+  mapped_length = length;
+  data_capacity = capacity;
+  created_name = name;
+
+  memcpy(header->magic, MAGIC, sizeof(MAGIC));
+  header->version = VERSION;
+  header->capacity = capacity;
+  header->length = 0;
+  header->result = SOLVER_UNDECIDED;
+  header->shutdown = 0;
+  header->served = 0;
+  sem_init(&header->request, 1, 0);
+  sem_init(&header->response, 1, 0);
+
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+  pthread_mutex_init(&header->worker, &attr);
+  pthread_mutexattr_destroy(&attr);
+  return true;
+}
+
+bool SharedQuery::open(const char* name)
+{
+  close();
+
+  const int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  void* region = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(SharedQueryHeader))
+    region = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                  0);
+  ::close(fd);
+  if (region == MAP_FAILED)
+    return false;
+
+  header = (SharedQueryHeader*)region;
+  mapped_length = st.st_size;
+  data_capacity = mapped_length - sizeof(SharedQueryHeader);
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION || header->capacity > data_capacity)
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void SharedQuery::close()
+{
+  if (header == NULL)
+    return;
+
+  if (!created_name.empty())
+  {
+    sem_destroy(&header->request);
+    sem_destroy(&header->response);
+    pthread_mutex_destroy(&header->worker);
+    shm_unlink(created_name.c_str());
+    created_name.clear();
+  }
+  munmap(header, mapped_length);
+  header = NULL;
+  mapped_length = 0;
+  data_capacity = 0;
+}
+
+char* SharedQuery::data()
+{
+  return (char*)(header + 1);
+}
+
+size_t SharedQuery::capacity() const
+{
+  return data_capacity;
+}
+
+void SharedQuery::submit(size_t length)
+{
+  assert(length <= data_capacity);
+  header->length = length;
+  sem_post(&header->request);
+}
+
+int SharedQuery::waitForResult()
+{
+  while (true)
+  {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += LIVENESS_CHECK_MS * 1000000;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+
+    if (sem_timedwait(&header->response, &deadline) == 0)
+      return header->result;
+    if (errno == EINTR)
+      continue;
+    if (errno != ETIMEDOUT)
+      FatalError("SharedQuery: sem_timedwait failed");
+    // It may have answered just before it went.
+    if (workerGone())
+      return (sem_trywait(&header->response) == 0) ? header->result
+                                                   : SOLVER_ERROR;
+  }
+}
+
+// A worker that hasn't started yet is waited for.
+bool SharedQuery::workerGone()
+{
+  if (!header->served)
+    return false;
+
+  const int r = pthread_mutex_trylock(&header->worker);
+  if (r == EBUSY)
+    return false;
+  if (r == EOWNERDEAD)
+    pthread_mutex_consistent(&header->worker);
+  else if (r != 0)
+    FatalError("SharedQuery: pthread_mutex_trylock failed");
+  pthread_mutex_unlock(&header->worker);
+  return true;
+}
+
+size_t SharedQuery::modelLength() const
+{
+  return header->length;
+}
+
+void SharedQuery::shutdown()
+{
+  header->shutdown = 1;
+  sem_post(&header->request);
+}
+
+void SharedQuery::serve(STP* stp)
+{
+  STPMgr* bm = stp->bm;
+  bm->UserFlags.construct_counterexample_flag = true;
+
+  // A worker before this one died while serving.
+  if (pthread_mutex_lock(&header->worker) == EOWNERDEAD)
+    pthread_mutex_consistent(&header->worker);
+  header->served = 1;
+
+  std::string model;
+  std::string error;
+  while (true)
+  {
+    semWait(&header->request);
+    if (header->shutdown)
+      break;
+
+    // The producer can write anything here, so nothing in it is trusted.
+    // The nodes are built straight from the segment.
+    const uint64_t length = header->length;
+    ASTNode query;
+    int result = SOLVER_ERROR;
+    model.clear();
+    if (length <= data_capacity &&
+        Binary_TryRead(*bm, data(), length, query, error) &&
+        query.GetType() == BOOLEAN_TYPE)
+    {
+      stp->ClearAllTables();
+      result = stp->TopLevelSTP(bm->ASTTrue, query);
+      if (result == SOLVER_INVALID)
+        printer::Binary_Print(model, buildModel(stp, query));
+    }
+
+    if (model.size() <= data_capacity)
+    {
+      memcpy(data(), model.data(), model.size());
+      header->length = model.size();
+    }
+    else
+      header->length = 0;
+    header->result = result;
+    sem_post(&header->response);
+  }
+
+  pthread_mutex_unlock(&header->worker);
+}
+
+#else
+
+struct SharedQueryHeader
+{
+};
+
+SharedQuery::SharedQuery()
+    : header(NULL), mapped_length(0), data_capacity(0)
+{
+}
+
+SharedQuery::~SharedQuery()
+{
+}
+
+bool SharedQuery::create(const char*, size_t)
+{
+  return false;
+}
+
+bool SharedQuery::open(const char*)
+{
+  return false;
+}
+
+void SharedQuery::close()
+{
+}
+
+char* SharedQuery::data()
+{
+  return NULL;
+}
+
+size_t SharedQuery::capacity() const
+{
+  return 0;
+}
+
+void SharedQuery::submit(size_t)
+{
+  FatalError("SharedQuery: not supported on this platform");
+}
+
+int SharedQuery::waitForResult()
+{
+  FatalError("SharedQuery: not supported on this platform");
+}
+
+bool SharedQuery::workerGone()
+{
+  return true;
+}
+
+size_t SharedQuery::modelLength() const
+{
+  return 0;
+}
+
+void SharedQuery::shutdown()
+{
+}
+
+void SharedQuery::serve(STP*)
+{
+  FatalError("SharedQuery: not supported on this platform");
+}
+
+#endif
+} // end namespace stp
@@ -26,10 +26,13 @@ THE SOFTWARE.
 #include <cstdlib>
 #include <cstdio>
 #include <cassert>
+#include <mutex>
 
 #include "stp/Interface/fdstream.h"
 #include "stp/Printer/printers.h"
 #include "stp/Parser/parser.h"
+#include "stp/Parser/BinaryReader.h"
+#include "stp/Util/MappedInput.h"
 #include "stp/cpp_interface.h"
 // FIXME: External library
 #include "extlib-abc/cnf_short.h"
@@ -80,11 +83,82 @@ void vc_setInterfaceFlags(VC vc, enum ifaceflag_t f, int param_value)
       //Array-based Minisat has been replaced with normal MiniSat
       b->UserFlags.solver_to_use = stp::UserDefinedFlags::MINISAT_SOLVER;
       break;
+    case INCREMENTAL:
+      b->UserFlags.incremental_solving = param_value != 0;
+      break;
+    case PORTFOLIO:
+      b->UserFlags.portfolio_threads = param_value;
+      break;
+    case BITBLAST_THREADS:
+      b->UserFlags.bitblast_threads = param_value;
+      break;
+    case QUERY_CACHE:
+      b->UserFlags.query_cache_size = param_value;
+      break;
+    case INDEPENDENCE_SLICING:
+      b->UserFlags.independence_slicing = param_value != 0;
+      break;
+    case MODEL_REUSE:
+      b->UserFlags.model_reuse_size = param_value;
+      break;
+    case UNSAT_CORE_CACHE:
+      b->UserFlags.unsat_core_cache_size = param_value;
+      break;
+    case AIG_SWEEP:
+      b->UserFlags.aig_sweep_flag = param_value != 0;
+      break;
+    case AIG_REWRITE:
+      b->UserFlags.enable_AIG_rewrites_flag = param_value != 0;
+      break;
     default:
       stp::FatalError(
           "C_interface: vc_setInterfaceFlags: Unrecognized flag\n");
       break;
   }
+
+  // Whatever solver was kept from earlier queries may no longer be wanted.
+  if (f != EXPRDELETE && f != PORTFOLIO && f != BITBLAST_THREADS &&
+      f != QUERY_CACHE && f != INDEPENDENCE_SLICING && f != MODEL_REUSE &&
+      f != UNSAT_CORE_CACHE)
+    ((stp::STP*)vc)->ClearIncrementalState();
+}
+
+long vc_getStatistic(VC vc, enum statistic_t s)
+{
+  stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
+  switch (s)
+  {
+    case QUERY_CACHE_HITS:
+      return b->GetRunTimes()->getCount(RunTimes::QueryCacheHit);
+    case QUERY_CACHE_MISSES:
+      return b->GetRunTimes()->getCount(RunTimes::QueryCacheMiss);
+    case QUERY_CACHE_FILE_HITS:
+      return b->GetRunTimes()->getCount(RunTimes::QueryCacheFileHit);
+    case MODEL_REUSE_HITS:
+      return b->GetRunTimes()->getCount(RunTimes::ModelReuseHit);
+    case MODEL_REUSE_MISSES:
+      return b->GetRunTimes()->getCount(RunTimes::ModelReuseMiss);
+    case AIG_SWEEP_MERGES:
+      return b->GetRunTimes()->getCount(RunTimes::AIGSweepMerge);
+    case AIG_REWRITE_STEPS:
+      return b->GetRunTimes()->getCount(RunTimes::AIGRewriteStep);
+    case AIG_REWRITE_NODES_REMOVED:
+      return b->GetRunTimes()->getCount(RunTimes::AIGRewriteRemoved);
+    default:
+      stp::FatalError("C_interface: vc_getStatistic: Unrecognized statistic");
+  }
+}
+
+void vc_setQueryCacheFile(VC vc, const char* path)
+{
+  stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
+  b->UserFlags.query_cache_file = (path == NULL) ? "" : path;
+}
+
+int vc_setAIGRewriteScript(VC vc, const char* script)
+{
+  stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
+  return b->UserFlags.setAIGRewriteScript(script) ? 1 : 0;
 }
 
 // Division is now always total
@@ -355,6 +429,22 @@ stp::ASTNode* persistNode(VC vc, stp::ASTNode n)
   return np;
 }
 
+void vc_serializeExpr(VC /*vc*/, Expr e, char** buf, unsigned long* len)
+{
+  string s;
+  printer::Binary_Print(s, *((stp::ASTNode*)e));
+  *buf = (char*)malloc(s.size());
+  *len = s.size();
+  memcpy(*buf, s.data(), s.size());
+}
+
+Expr vc_deserializeExpr(VC vc, const char* buf, unsigned long len)
+{
+  stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
+  stp::ASTNode n = stp::Binary_Read(*b, buf, len);
+  return persistNode(vc, n);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Array-related methods                                                   //
 /////////////////////////////////////////////////////////////////////////////
@@ -476,7 +566,8 @@ int vc_query_with_timeout(VC vc, Expr e, int timeout_ms)
   const stp::ASTVec v = b->GetAsserts();
   stp::ASTNode o;
   int output;
-  stpObj->bm->UserFlags.timeout_max_conflicts = timeout_ms;
+  stpObj->bm->UserFlags.timeout_max_conflicts = -1;
+  stpObj->bm->UserFlags.timeout_max_time = timeout_ms;
   if (!v.empty())
   {
     if (v.size() == 1)
@@ -496,6 +587,54 @@ int vc_query_with_timeout(VC vc, Expr e, int timeout_ms)
   return output;
 }
 
+int vc_queryWithAssumptions(VC vc, Expr* assumptions, int numAssumptions)
+{
+  stp::STP* stpObj = ((stp::STP*)vc);
+  stp::STPMgr* b = (stp::STPMgr*)(stpObj->bm);
+
+  stp::ASTVec assumed;
+  for (int i = 0; i < numAssumptions; i++)
+  {
+    stp::ASTNode* a = (stp::ASTNode*)assumptions[i];
+    if (!stp::is_Form_kind(a->GetKind()))
+    {
+      stp::FatalError("CInterface: Trying to ASSUME a NON formula: ", *a);
+    }
+    assert(BVTypeCheck(*a));
+    assumed.push_back(*a);
+  }
+
+  stpObj->ClearAllTables();
+
+  const stp::ASTVec v = b->GetAsserts();
+  stp::ASTNode asserts;
+  if (v.empty())
+    asserts = b->CreateNode(stp::TRUE);
+  else if (v.size() == 1)
+    asserts = v[0];
+  else
+    asserts = b->CreateNode(stp::AND, v);
+
+  stpObj->bm->UserFlags.timeout_max_conflicts = -1;
+  stpObj->bm->UserFlags.timeout_max_time = -1;
+  return stpObj->TopLevelSTPWithAssumptions(asserts, assumed);
+}
+
+void vc_getFailedAssumptions(VC vc, Expr** failed, int* size)
+{
+  const stp::ASTVec& f = ((stp::STP*)vc)->GetFailedAssumptions();
+  *size = f.size();
+  *failed = NULL;
+  if (*size != 0)
+  {
+    *failed = (Expr*)malloc(*size * sizeof(Expr*));
+    assert(*failed);
+
+    for (int i = 0; i < *size; ++i)
+      (*failed)[i] = new stp::ASTNode(f[i]);
+  }
+}
+
 // int vc_absRefineQuery(VC vc, Expr e) {
 //   stp::ASTNode* a = (stp::ASTNode*)e;
 //   stp::STPMgr* b   = (stp::STPMgr*)(((stp::STP*)vc)->bm);
@@ -1646,11 +1785,11 @@ static char *val_to_binary_str(unsigned nbits, unsigned long long val) {
 Expr vc_parseExpr(VC vc, const char* infile)
 {
   stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
-  extern FILE* cvcin, *smtin;
   const char* prog = "stp";
 
-  cvcin = fopen(infile, "r");
-  if (cvcin == NULL)
+  std::lock_guard<std::mutex> parser_lock(stp::GlobalParserMutex);
+  stp::MappedInput input;
+  if (!input.open(infile))
   {
     fprintf(stderr, "%s: Error: cannot open %s\n", prog, infile);
     stp::FatalError("Cannot open file");
@@ -1664,28 +1803,27 @@ Expr vc_parseExpr(VC vc, const char* infile)
     return 0;
   }
 
+  stp::GlobalSTP = ((stp::STP*)vc);
+  stp::GlobalParserBM = b;
   stp::Cpp_interface pi(*b, b->defaultNodeFactory);
   stp::GlobalParserInterface = &pi;
 
   stp::ASTVec* AssertsQuery = new stp::ASTVec;
   if (b->UserFlags.smtlib1_parser_flag)
   {
-    smtin = cvcin;
-    cvcin = NULL;
-    stp::GlobalSTP = ((stp::STP*)vc);
-    stp::GlobalParserBM = b;
+    stp::SMTScanBuffer(input.buffer(), input.size());
     smtparse((void*)AssertsQuery);
-    stp::GlobalSTP = NULL;
-    stp::GlobalParserBM = NULL;
+    smtlex_destroy();
   }
   else
   {
-    stp::GlobalSTP = ((stp::STP*)vc);
-    stp::GlobalParserBM = b;
+    stp::CVCScanBuffer(input.buffer(), input.size());
     cvcparse((void*)AssertsQuery);
-    stp::GlobalSTP = NULL;
-    stp::GlobalParserBM = NULL;
+    cvclex_destroy();
   }
+  stp::GlobalSTP = NULL;
+  stp::GlobalParserBM = NULL;
+  stp::GlobalParserInterface = NULL;
 
   stp::ASTNode asserts = (*(stp::ASTVec*)AssertsQuery)[0];
   stp::ASTNode query = (*(stp::ASTVec*)AssertsQuery)[1];
@@ -1968,48 +2106,40 @@ void process_argument(const char ch, VC vc)
 // extended version
 
 
-int vc_parseMemExpr(VC vc, const char* s, Expr* oquery, Expr* oasserts)
+// Parses from the string s, or in place from buffer when that is given.
+static int parseMem(VC vc, const char* s, char* buffer, size_t length,
+                    Expr* oquery, Expr* oasserts)
 {
   stp::STPMgr* b = (stp::STPMgr*)(((stp::STP*)vc)->bm);
 
-#if 0
- stp::GlobalSTP = (stp::STP*)vc;
-  CONSTANTBV::ErrCode c = CONSTANTBV::BitVector_Boot();
-  if(0 != c) {
-    cout << CONSTANTBV::BitVector_Error(c) << endl;
-    return 0;
-  }
-#endif
-
+  std::lock_guard<std::mutex> parser_lock(stp::GlobalParserMutex);
+  stp::GlobalSTP = ((stp::STP*)vc);
+  stp::GlobalParserBM = b;
   stp::Cpp_interface pi(*b, b->defaultNodeFactory);
   stp::GlobalParserInterface = &pi;
 
   stp::ASTVec AssertsQuery;
   if (b->UserFlags.smtlib1_parser_flag)
   {
-    // YY_BUFFER_STATE bstat = smt_scan_string(s);
-    // smt_switch_to_buffer(bstat);
-    stp::GlobalSTP = ((stp::STP*)vc);
-    stp::GlobalParserBM = b;
-    stp::SMTScanString(s);
+    if (buffer != NULL)
+      stp::SMTScanBuffer(buffer, length);
+    else
+      stp::SMTScanString(s);
     smtparse((void*)&AssertsQuery);
-    // smt_delete_buffer(bstat);
-    stp::GlobalSTP = NULL;
-    stp::GlobalParserBM = NULL;
-
+    smtlex_destroy();
   }
   else
   {
-    // YY_BUFFER_STATE bstat = cvc_scan_string(s);
-    // cvc_switch_to_buffer(bstat);
-    stp::GlobalSTP = ((stp::STP*)vc);
-    stp::GlobalParserBM = b;
-    stp::CVCScanString(s);
+    if (buffer != NULL)
+      stp::CVCScanBuffer(buffer, length);
+    else
+      stp::CVCScanString(s);
     cvcparse((void*)&AssertsQuery);
-    // cvc_delete_buffer(bstat);
-    stp::GlobalSTP = NULL;
-    stp::GlobalParserBM = NULL;
+    cvclex_destroy();
   }
+  stp::GlobalSTP = NULL;
+  stp::GlobalParserBM = NULL;
+  stp::GlobalParserInterface = NULL;
 
   if (oquery)
   {
@@ -2021,3 +2151,14 @@ int vc_parseMemExpr(VC vc, const char* s, Expr* oquery, Expr* oasserts)
   }
   return 1;
 }
+
+int vc_parseMemExpr(VC vc, const char* s, Expr* oquery, Expr* oasserts)
+{
+  return parseMem(vc, s, NULL, 0, oquery, oasserts);
+}
+
+int vc_parseMemBuffer(VC vc, char* buffer, unsigned long length, Expr* oquery,
+                      Expr* oasserts)
+{
+  return parseMem(vc, NULL, buffer, length, oquery, oasserts);
+}
@@ -36,6 +36,22 @@ using std::endl;
 namespace stp
 {
 
+// The CNF generator's SOP tables take a while to build, so they're kept
+// between queries. What it keeps besides them is about as big as the cuts
+// of the last query, which is only worth giving back when it's large.
+static const size_t cnf_memory_kept = 64 << 20;
+
+static void releaseLargeCnfMemory()
+{
+  Cnf_Man_t* p = Cnf_ManRead();
+  if (p == NULL)
+    return;
+  const size_t held = (size_t)Aig_MmFlexReadMemUsage(p->pMemCuts) +
+                      sizeof(int) * (size_t)p->vMemory->nCap;
+  if (held > cnf_memory_kept)
+    Cnf_ClearMemory();
+}
+
 void Cpp_interface::checkInvariant()
 {
   assert(bm.getAssertLevel() == cache.size());
@@ -59,7 +75,8 @@ void Cpp_interface::init()
 }
 
 Cpp_interface::Cpp_interface(STPMgr& bm_, NodeFactory* factory)
-    : bm(bm_), letMgr(new LETMgr(bm.ASTUndefined)), nf(factory)
+    : bm(bm_), solver(GlobalSTP), letMgr(new LETMgr(bm.ASTUndefined)),
+      nf(factory)
 {
   init();
 }
@@ -301,7 +318,7 @@ void Cpp_interface::unsupported()
 void Cpp_interface::resetSolver()
 {
   bm.ClearAllTables();
-  GlobalSTP->ClearAllTables();
+  solver->ClearAllTables();
 }
 
 // Can clear away the base frame..
@@ -322,6 +339,7 @@ void Cpp_interface::reset()
   // These tables might hold references to symbols that have been
   // removed.
   resetSolver();
+  solver->ClearIncrementalState();
 
   cleanUp();
   
@@ -428,7 +446,7 @@ void Cpp_interface::checkSat(const ASTVec& assertionsSMT2)
     else
       query = bm.ASTTrue;
 
-    SOLVER_RETURN_TYPE last_result = GlobalSTP->TopLevelSTP(query, bm.ASTFalse);
+    SOLVER_RETURN_TYPE last_result = solver->TopLevelSTP(query, bm.ASTFalse);
 
     // Store away the answer. Might be timeout, or error though..
     last_run = Entry(last_result);
@@ -450,13 +468,27 @@ void Cpp_interface::checkSat(const ASTVec& assertionsSMT2)
     bm.GetRunTimes()->print();
   }
 
-  (GlobalSTP->tosat)->PrintOutput(last_run.result);
+  (solver->tosat)->PrintOutput(last_run.result);
+
+  // The model is kept for get-model and get-value, everything else that
+  // was built for this query can go now rather than at the next one.
+  if (bm.UserFlags.streaming_flag)
+  {
+    bm.ClearAllTables();
+    solver->simp->ClearAllTables();
+    solver->arrayTransformer->ClearAllTables();
+    solver->tosat->ClearAllTables();
+    if (!bm.UserFlags.incremental_solving)
+      releaseLargeCnfMemory();
+  }
+
   bm.GetRunTimes()->start(RunTimes::Parsing);
 }
 
 // This method sets up some of the globally required data.
 Cpp_interface::Cpp_interface(STPMgr& bm_)
-    : bm(bm_), letMgr(new LETMgr(bm.ASTUndefined)), nf(bm_.defaultNodeFactory)
+    : bm(bm_), solver(NULL), letMgr(new LETMgr(bm.ASTUndefined)),
+      nf(bm_.defaultNodeFactory)
 {
   nf = bm.defaultNodeFactory;
   startup();
@@ -469,14 +501,18 @@ Cpp_interface::Cpp_interface(STPMgr& bm_)
 
   stp::GlobalParserBM = &bm_;
 
-  GlobalSTP = new STP(&bm, simp, at, tosat, abs);
+  solver = new STP(&bm, simp, at, tosat, abs);
+  GlobalSTP = solver;
   init();
 }
 
 void Cpp_interface::deleteGlobal()
 {
-  GlobalSTP->deleteObjects();
-  delete GlobalSTP;
+  solver->deleteObjects();
+  if (GlobalSTP == solver)
+    GlobalSTP = NULL;
+  delete solver;
+  solver = NULL;
 }
 
 void Cpp_interface::cleanUp()
@@ -536,12 +572,9 @@ void Cpp_interface::cleanUp()
       unsupported();
   }
 
+  // Printed straight to cout, so that big values aren't held as strings.
   void Cpp_interface::getValue(const ASTVec &v)
   {
-    std::ostringstream os;
-
-    os << "("<< std::endl;
-    
     for (ASTNode n: v)
       {
         if (n.GetKind() != SYMBOL)
@@ -549,12 +582,15 @@ void Cpp_interface::cleanUp()
           unsupported();
           return;
         }
-        GlobalSTP->Ctr_Example->PrintSMTLIB2(os,n);
-        os << std::endl;        
       }
-    os << ")" << std::endl;
 
-    cout << os.str();
+    cout << "("<< std::endl;
+    for (ASTNode n: v)
+      {
+        solver->Ctr_Example->PrintSMTLIB2(cout,n);
+        cout << std::endl;
+      }
+    cout << ")" << std::endl;
   }
 
   void Cpp_interface::getModel()
@@ -562,10 +598,7 @@ void Cpp_interface::cleanUp()
     //TODO check that produce-models is turned on.
     //Check that check-sat was just called.
     cout << "("<< std::endl;
-
-    std::ostringstream os;
-    GlobalSTP->Ctr_Example->PrintCounterExampleSMTLIB2(os);
-    cout << os.str();
+    solver->Ctr_Example->PrintCounterExampleSMTLIB2(cout);
     cout << ")" << std::endl;
   }
 
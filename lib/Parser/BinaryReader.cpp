@@ -0,0 +1,447 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/Parser/BinaryReader.h"
+#include "stp/Printer/BinaryFormat.h"
+#include "stp/STPManager/STPManager.h"
+#include "stp/AST/NodeFactory/HashingNodeFactory.h"
+#include <cstring>
+
+namespace stp
+{
+using std::string;
+
+namespace
+{
+// What's wrong with the input.
+struct Malformed
+{
+  explicit Malformed(const string& r) : reason(r) {}
+  string reason;
+};
+
+// Bounds checked reads from the input.
+class Cursor
+{
+public:
+  Cursor(const char* data, size_t length)
+      : pos((const unsigned char*)data),
+        end((const unsigned char*)data + length)
+  {
+  }
+
+  const unsigned char* take(size_t n)
+  {
+    if (remaining() < n)
+      throw Malformed("truncated input");
+    const unsigned char* p = pos;
+    pos += n;
+    return p;
+  }
+
+  uint32_t u32() { return binary::getU32(take(4)); }
+  unsigned char byte() { return *take(1); }
+  size_t remaining() const { return end - pos; }
+  bool atEnd() const { return pos == end; }
+
+private:
+  const unsigned char* pos;
+  const unsigned char* end;
+};
+
+// The smallest number of bytes each of these takes up in the input.
+const size_t MIN_SYMBOL_SIZE = 4;
+const size_t MIN_NODE_SIZE = 9;
+const size_t CHILD_SIZE = 4;
+
+ASTNode readSymbol(STPMgr& bm, const string& name, uint32_t indexWidth,
+                   uint32_t valueWidth)
+{
+  if (valueWidth == 0 && indexWidth != 0)
+    throw Malformed("array symbol of width zero");
+
+  // CreateSymbol would give an existing symbol the new widths.
+  ASTNode existing;
+  if (bm.LookupSymbol(name.c_str(), existing))
+  {
+    if (existing.GetValueWidth() != valueWidth ||
+        existing.GetIndexWidth() != indexWidth)
+      throw Malformed("symbol " + name + " has another width here");
+    return existing;
+  }
+  return bm.hashingNodeFactory->CreateSymbol(name.c_str(), indexWidth,
+                                             valueWidth);
+}
+
+bool isFormula(const ASTNode& n)
+{
+  return n.GetType() == BOOLEAN_TYPE;
+}
+
+bool isBitVector(const ASTNode& n)
+{
+  return n.GetType() == BITVECTOR_TYPE;
+}
+
+void requireArity(const ASTVec& children, size_t min, size_t max)
+{
+  if (children.size() < min || children.size() > max)
+    throw Malformed("wrong number of children");
+}
+
+void requireFormulas(const ASTVec& children)
+{
+  for (size_t i = 0; i < children.size(); i++)
+    if (!isFormula(children[i]))
+      throw Malformed("term where a formula was expected");
+}
+
+void requireBitVectors(const ASTVec& children, uint32_t width)
+{
+  for (size_t i = 0; i < children.size(); i++)
+    if (!isBitVector(children[i]) || children[i].GetValueWidth() != width)
+      throw Malformed("operand of the wrong width");
+}
+
+// The constants that give bit positions are small, GetUnsignedConst
+// gives up on the rest.
+unsigned smallConstant(const ASTNode& n)
+{
+  if (n.GetKind() != BVCONST ||
+      CONSTANTBV::Set_Max(n.GetBVConst()) >= (long)(8 * sizeof(unsigned)))
+    throw Malformed("bit position that isn't a small constant");
+  return n.GetUnsignedConst();
+}
+
+// The same rules as BVTypeCheck, which reports through FatalError, and
+// can only check a node once it's been made. A node that fails is never
+// made, so it can't be found later by another expression.
+void typeCheck(Kind kind, uint32_t indexWidth, uint32_t valueWidth,
+               const ASTVec& children)
+{
+  const ASTVec& c = children;
+  const size_t ANY = (size_t)-1;
+
+  if (valueWidth == 0)
+  {
+    switch (kind)
+    {
+      case NOT:
+        requireArity(c, 1, 1);
+        requireFormulas(c);
+        break;
+      case AND:
+      case OR:
+      case XOR:
+      case NAND:
+      case NOR:
+        requireArity(c, 2, ANY);
+        requireFormulas(c);
+        break;
+      case IFF:
+      case IMPLIES:
+        requireArity(c, 2, 2);
+        requireFormulas(c);
+        break;
+      case ITE:
+        requireArity(c, 3, 3);
+        requireFormulas(c);
+        break;
+      case EQ:
+        requireArity(c, 2, 2);
+        if (c[0].GetValueWidth() != c[1].GetValueWidth() ||
+            c[0].GetIndexWidth() != c[1].GetIndexWidth())
+          throw Malformed("operand of the wrong width");
+        break;
+      case BVLT:
+      case BVLE:
+      case BVGT:
+      case BVGE:
+      case BVSLT:
+      case BVSLE:
+      case BVSGT:
+      case BVSGE:
+        requireArity(c, 2, 2);
+        requireBitVectors(c, c[0].GetValueWidth());
+        break;
+      case BOOLEXTRACT:
+        requireArity(c, 2, 2);
+        requireBitVectors(ASTVec(1, c[0]), c[0].GetValueWidth());
+        if (smallConstant(c[1]) >= c[0].GetValueWidth())
+          throw Malformed("bit position past the end");
+        break;
+      case PARAMBOOL:
+        requireArity(c, 2, 2);
+        break;
+      default:
+        throw Malformed("formula of a kind that isn't a formula");
+    }
+    return;
+  }
+
+  switch (kind)
+  {
+    case ITE:
+      requireArity(c, 3, 3);
+      requireFormulas(ASTVec(1, c[0]));
+      for (size_t i = 1; i < 3; i++)
+        if (c[i].GetValueWidth() != valueWidth ||
+            c[i].GetIndexWidth() != indexWidth)
+          throw Malformed("operand of the wrong width");
+      return;
+    case READ:
+      requireArity(c, 2, 2);
+      if (c[0].GetType() != ARRAY_TYPE || !isBitVector(c[1]) ||
+          c[0].GetIndexWidth() != c[1].GetValueWidth() ||
+          c[0].GetValueWidth() != valueWidth || indexWidth != 0)
+        throw Malformed("operand of the wrong width");
+      return;
+    case WRITE:
+      requireArity(c, 3, 3);
+      if (c[0].GetType() != ARRAY_TYPE || !isBitVector(c[1]) ||
+          !isBitVector(c[2]) ||
+          c[0].GetIndexWidth() != c[1].GetValueWidth() ||
+          c[0].GetValueWidth() != c[2].GetValueWidth() ||
+          c[0].GetValueWidth() != valueWidth ||
+          c[0].GetIndexWidth() != indexWidth)
+        throw Malformed("operand of the wrong width");
+      return;
+    default:
+      break;
+  }
+
+  // Everything else is a bitvector.
+  if (indexWidth != 0)
+    throw Malformed("array of a kind that isn't an array");
+
+  switch (kind)
+  {
+    case BVDIV:
+    case BVMOD:
+    case BVSUB:
+    case SBVDIV:
+    case SBVREM:
+    case SBVMOD:
+    case BVLEFTSHIFT:
+    case BVRIGHTSHIFT:
+    case BVSRSHIFT:
+      requireArity(c, 2, 2);
+      requireBitVectors(c, valueWidth);
+      break;
+    case BVOR:
+    case BVAND:
+    case BVXOR:
+    case BVNOR:
+    case BVNAND:
+    case BVXNOR:
+    case BVPLUS:
+    case BVMULT:
+      requireArity(c, 2, ANY);
+      requireBitVectors(c, valueWidth);
+      break;
+    case BVUMINUS:
+    case BVNOT:
+      requireArity(c, 1, 1);
+      requireBitVectors(c, valueWidth);
+      break;
+    case BVSX:
+    case BVZX:
+      requireArity(c, 2, 2);
+      if (!isBitVector(c[0]) || c[0].GetValueWidth() > valueWidth ||
+          !isBitVector(c[1]))
+        throw Malformed("operand of the wrong width");
+      break;
+    case BVCONCAT:
+      requireArity(c, 2, 2);
+      if (!isBitVector(c[0]) || !isBitVector(c[1]) ||
+          (uint64_t)c[0].GetValueWidth() + c[1].GetValueWidth() != valueWidth)
+        throw Malformed("operand of the wrong width");
+      break;
+    case BVEXTRACT:
+    {
+      requireArity(c, 3, 3);
+      if (!isBitVector(c[0]))
+        throw Malformed("operand of the wrong width");
+      const unsigned high = smallConstant(c[1]);
+      const unsigned low = smallConstant(c[2]);
+      if (high < low || high >= c[0].GetValueWidth())
+        throw Malformed("bit position past the end");
+      if ((uint64_t)high - low + 1 != valueWidth)
+        throw Malformed("operand of the wrong width");
+      break;
+    }
+    default:
+      throw Malformed("term of a kind that isn't a term");
+  }
+}
+
+ASTNode readInterior(STPMgr& bm, Kind kind, uint32_t indexWidth,
+                     uint32_t valueWidth, const ASTVec& children)
+{
+  // Checked before the node is made, as the node factory doesn't check
+  // them, and would change the widths of a node that already exists.
+  if (valueWidth == 0 && indexWidth != 0)
+    throw Malformed("array of width zero");
+  typeCheck(kind, indexWidth, valueWidth, children);
+
+  ASTNode n = bm.hashingNodeFactory->CreateNode(kind, children);
+  if (n.GetValueWidth() == 0 && n.GetIndexWidth() == 0)
+  {
+    // New, or a formula that was already there.
+    n.SetValueWidth(valueWidth);
+    n.SetIndexWidth(indexWidth);
+  }
+  else if (n.GetValueWidth() != valueWidth ||
+           n.GetIndexWidth() != indexWidth)
+    throw Malformed("node has another width here");
+
+  return n;
+}
+
+ASTNode read(STPMgr& bm, const char* data, size_t length)
+{
+  Cursor in(data, length);
+  if (memcmp(in.take(sizeof(binary::MAGIC)), binary::MAGIC,
+             sizeof(binary::MAGIC)) != 0)
+    throw Malformed("not a serialized expression");
+  if (in.u32() != binary::VERSION)
+    throw Malformed("unsupported version");
+
+  const uint32_t symbolCount = in.u32();
+  if (symbolCount > in.remaining() / MIN_SYMBOL_SIZE)
+    throw Malformed("truncated input");
+  std::vector<string> symbols;
+  symbols.reserve(symbolCount);
+  for (uint32_t i = 0; i < symbolCount; i++)
+  {
+    const uint32_t nameLength = in.u32();
+    const char* name = (const char*)in.take(nameLength);
+    symbols.push_back(string(name, nameLength));
+  }
+
+  const uint32_t nodeCount = in.u32();
+  if (nodeCount == 0)
+    throw Malformed("no nodes");
+  if (nodeCount > in.remaining() / MIN_NODE_SIZE)
+    throw Malformed("truncated input");
+
+  ASTVec nodes;
+  nodes.reserve(nodeCount);
+  ASTVec children;
+  for (uint32_t i = 0; i < nodeCount; i++)
+  {
+    const unsigned k = in.byte();
+    if (k >= (unsigned)KIND_COUNT)
+      throw Malformed("bad kind");
+    const Kind kind = (Kind)k;
+    const uint32_t valueWidth = in.u32();
+    const uint32_t indexWidth = in.u32();
+
+    switch (kind)
+    {
+      case TRUE:
+        nodes.push_back(bm.ASTTrue);
+        break;
+      case FALSE:
+        nodes.push_back(bm.ASTFalse);
+        break;
+      case UNDEFINED:
+        nodes.push_back(bm.ASTUndefined);
+        break;
+      case SYMBOL:
+      {
+        const uint32_t s = in.u32();
+        if (s >= symbols.size())
+          throw Malformed("bad symbol index");
+        nodes.push_back(readSymbol(bm, symbols[s], indexWidth, valueWidth));
+        break;
+      }
+      case BVCONST:
+      {
+        if (valueWidth == 0)
+          throw Malformed("constant of width zero");
+        if (indexWidth != 0)
+          throw Malformed("constant with an index width");
+        if (in.remaining() < (valueWidth + (size_t)7) / 8)
+          throw Malformed("truncated input");
+        CBV bv = CONSTANTBV::BitVector_Create(valueWidth, true);
+        for (unsigned bit = 0; bit < valueWidth; bit += 8)
+        {
+          const unsigned chunk = (valueWidth - bit < 8) ? valueWidth - bit : 8;
+          CONSTANTBV::BitVector_Chunk_Store(bv, chunk, bit, in.byte());
+        }
+        nodes.push_back(bm.CreateBVConst(bv, valueWidth));
+        break;
+      }
+      default:
+      {
+        const uint32_t arity = in.u32();
+        if (arity > in.remaining() / CHILD_SIZE)
+          throw Malformed("truncated input");
+        children.clear();
+        children.reserve(arity);
+        for (uint32_t c = 0; c < arity; c++)
+        {
+          const uint32_t child = in.u32();
+          if (child >= i)
+            throw Malformed("child written after its parent");
+          children.push_back(nodes[child]);
+        }
+        nodes.push_back(
+            readInterior(bm, kind, indexWidth, valueWidth, children));
+      }
+    }
+  }
+
+  if (!in.atEnd())
+    throw Malformed("trailing bytes");
+  return nodes.back();
+}
+}
+
+bool Binary_TryRead(STPMgr& bm, const char* data, size_t length,
+                    ASTNode& result, string& error)
+{
+  try
+  {
+    result = read(bm, data, length);
+    return true;
+  }
+  catch (const Malformed& m)
+  {
+    error = "Binary_Read: " + m.reason;
+    return false;
+  }
+}
+
+ASTNode Binary_Read(STPMgr& bm, const char* data, size_t length)
+{
+  ASTNode result;
+  string error;
+  if (!Binary_TryRead(bm, data, length, result, error))
+    FatalError(error.c_str());
+  return result;
+}
+} // end namespace stp
@@ -0,0 +1,1181 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/Parser/SMT2Parser.h"
+#include "stp/Globals/Globals.h"
+#include "stp/Parser/LetMgr.h"
+#include "stp/cpp_interface.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace stp
+{
+using std::cout;
+using std::endl;
+using std::string;
+
+namespace
+{
+bool isLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool isHexDigit(char c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// OPCHAR in smt2.lex.
+bool isOpChar(char c)
+{
+  return c != '\0' && strchr("~!@$%^&*_-+=<>.?/", c) != NULL;
+}
+
+bool isWordChar(char c)
+{
+  return isLetter(c) || isDigit(c) || isOpChar(c);
+}
+}
+
+SMT2Parser::SMT2Parser(Cpp_interface& interface)
+    : tok(T_END), keyword(K_NONE), numeral(0), begin(NULL), pos(NULL),
+      end(NULL), token_start(NULL), scratch_depth(0), pi(interface)
+{
+}
+
+SMT2Parser::Keyword SMT2Parser::classify(const string& word)
+{
+  static const std::unordered_map<string, Keyword> keywords = {
+      {"assert", K_ASSERT},
+      {"check-sat", K_CHECK_SAT},
+      {"check-sat-assuming", K_CHECK_SAT_ASSUMING},
+      {"declare-const", K_DECLARE_CONST},
+      {"declare-fun", K_DECLARE_FUN},
+      {"define-fun", K_DEFINE_FUN},
+      {"echo", K_ECHO},
+      {"exit", K_EXIT},
+      {"get-model", K_GET_MODEL},
+      {"get-value", K_GET_VALUE},
+      {"pop", K_POP},
+      {"push", K_PUSH},
+      {"reset", K_RESET},
+      {"set-info", K_SET_INFO},
+      {"set-logic", K_SET_LOGIC},
+      {"set-option", K_SET_OPTION},
+      {"declare-sort", K_UNSUPPORTED_COMMAND},
+      {"define-fun-rec", K_UNSUPPORTED_COMMAND},
+      {"define-funs-rec", K_UNSUPPORTED_COMMAND},
+      {"define-sort", K_UNSUPPORTED_COMMAND},
+      {"get-assertions", K_UNSUPPORTED_COMMAND},
+      {"get-assignment", K_UNSUPPORTED_COMMAND},
+      {"get-info", K_UNSUPPORTED_COMMAND},
+      {"get-option", K_UNSUPPORTED_COMMAND},
+      {"get-proof", K_UNSUPPORTED_COMMAND},
+      {"get-unsat-assumption", K_UNSUPPORTED_COMMAND},
+      {"get-unsat-assumptions", K_UNSUPPORTED_COMMAND},
+      {"get-unsat-core", K_UNSUPPORTED_COMMAND},
+      {"reset-assertions", K_UNSUPPORTED_COMMAND},
+      {"BitVec", K_BITVEC},
+      {"Array", K_ARRAY},
+      {"Bool", K_BOOL},
+      {"true", K_TRUE},
+      {"false", K_FALSE},
+      {"not", K_NOT},
+      {"and", K_AND},
+      {"or", K_OR},
+      {"xor", K_XOR},
+      {"ite", K_ITE},
+      {"=", K_EQ},
+      {"=>", K_IMPLIES},
+      {"distinct", K_DISTINCT},
+      {"let", K_LET},
+      {"_", K_UNDERSCORE},
+      {"!", K_BANG},
+      {"bvshl", K_BVSHL},
+      {"bvlshr", K_BVLSHR},
+      {"bvashr", K_BVASHR},
+      {"bvadd", K_BVADD},
+      {"bvsub", K_BVSUB},
+      {"bvnot", K_BVNOT},
+      {"bvmul", K_BVMUL},
+      {"bvudiv", K_BVUDIV},
+      {"bvsdiv", K_BVSDIV},
+      {"bvurem", K_BVUREM},
+      {"bvsrem", K_BVSREM},
+      {"bvsmod", K_BVSMOD},
+      {"bvneg", K_BVNEG},
+      {"bvand", K_BVAND},
+      {"bvor", K_BVOR},
+      {"bvxor", K_BVXOR},
+      {"bvnand", K_BVNAND},
+      {"bvnor", K_BVNOR},
+      {"bvxnor", K_BVXNOR},
+      {"concat", K_CONCAT},
+      {"extract", K_EXTRACT},
+      {"bvult", K_BVULT},
+      {"bvugt", K_BVUGT},
+      {"bvule", K_BVULE},
+      {"bvuge", K_BVUGE},
+      {"bvslt", K_BVSLT},
+      {"bvsgt", K_BVSGT},
+      {"bvsle", K_BVSLE},
+      {"bvsge", K_BVSGE},
+      {"bvcomp", K_BVCOMP},
+      {"zero_extend", K_ZERO_EXTEND},
+      {"sign_extend", K_SIGN_EXTEND},
+      {"repeat", K_REPEAT},
+      {"rotate_left", K_ROTATE_LEFT},
+      {"rotate_right", K_ROTATE_RIGHT},
+      {"select", K_SELECT},
+      {"store", K_STORE}};
+
+  std::unordered_map<string, Keyword>::const_iterator it = keywords.find(word);
+  if (it != keywords.end())
+    return it->second;
+
+  // As in smt2.lex, bv followed by digits is always the value of a
+  // (_ bvN w) constant.
+  if (word.size() > 2 && word[0] == 'b' && word[1] == 'v' &&
+      std::all_of(word.begin() + 2, word.end(), isDigit))
+    return K_BV_CONST;
+
+  return K_NONE;
+}
+
+int SMT2Parser::parse(const char* input, size_t length)
+{
+  begin = pos = token_start = input;
+  end = input + length;
+  scratch_depth = 0;
+
+  try
+  {
+    next();
+    while (tok != T_END)
+    {
+      expect(T_LPAREN, "expected a command");
+      if (!command())
+        return 0;
+    }
+  }
+  catch (const SyntaxError&)
+  {
+    for (size_t i = 0; i < scratch.size(); i++)
+      scratch[i].clear();
+    scratch_depth = 0;
+    return 1;
+  }
+
+  pi.cleanUp();
+  return 0;
+}
+
+/********************************************************************
+ * Lexing
+ ********************************************************************/
+
+void SMT2Parser::next()
+{
+  while (pos < end)
+  {
+    const char c = *pos;
+    if (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f')
+      pos++;
+    else if (c == ';')
+      while (pos < end && *pos != '\n')
+        pos++;
+    else
+      break;
+  }
+
+  token_start = pos;
+  if (pos >= end)
+  {
+    tok = T_END;
+    return;
+  }
+
+  const char c = *pos;
+  if (c == '(')
+  {
+    pos++;
+    tok = T_LPAREN;
+  }
+  else if (c == ')')
+  {
+    pos++;
+    tok = T_RPAREN;
+  }
+  else if (isDigit(c))
+  {
+    while (pos < end && isDigit(*pos))
+      pos++;
+    if (pos + 1 < end && *pos == '.' && isDigit(pos[1]))
+    {
+      pos++;
+      while (pos < end && isDigit(*pos))
+        pos++;
+      tok = T_DECIMAL;
+      return;
+    }
+    // As in smt2.lex, numerals are limited to an unsigned.
+    numeral = strtoul(token_start, NULL, 10);
+    tok = T_NUMERAL;
+  }
+  else if (isLetter(c) || isOpChar(c))
+  {
+    while (pos < end && isWordChar(*pos))
+      pos++;
+    text.assign(token_start, pos);
+    keyword = classify(text);
+    tok = T_SYMBOL;
+  }
+  else if (c == '|')
+  {
+    // The bars aren't part of the name.
+    const char* close = (const char*)memchr(pos + 1, '|', end - pos - 1);
+    if (close == NULL)
+      error("unterminated quoted symbol");
+    text.assign(pos + 1, close);
+    pos = close + 1;
+    keyword = K_NONE;
+    tok = T_SYMBOL;
+  }
+  else if (c == '#')
+  {
+    pos++;
+    if (pos < end && *pos == 'b')
+    {
+      pos++;
+      while (pos < end && isDigit(*pos))
+        pos++;
+      tok = T_BINARY;
+    }
+    else if (pos < end && *pos == 'x')
+    {
+      pos++;
+      while (pos < end && isHexDigit(*pos))
+        pos++;
+      tok = T_HEX;
+    }
+    else
+      error("Illegal input character.");
+
+    if (pos == token_start + 2)
+      error("Illegal input character.");
+    text.assign(token_start + 2, pos);
+  }
+  else if (c == '"')
+  {
+    // A doubled quote is the only escape.
+    text.clear();
+    pos++;
+    while (true)
+    {
+      const char* quote = (const char*)memchr(pos, '"', end - pos);
+      if (quote == NULL)
+        error("unterminated string literal");
+      text.append(pos, quote);
+      pos = quote + 1;
+      if (pos < end && *pos == '"')
+      {
+        text.push_back('"');
+        pos++;
+      }
+      else
+        break;
+    }
+    tok = T_STRING;
+  }
+  else if (c == ':')
+  {
+    pos++;
+    while (pos < end && isWordChar(*pos))
+      pos++;
+    text.assign(token_start + 1, pos);
+    tok = T_ATTRIBUTE;
+  }
+  else
+  {
+    pos++;
+    error("Illegal input character.");
+  }
+}
+
+void SMT2Parser::warn(const string& msg)
+{
+  const long line = 1 + std::count(begin, token_start, '\n');
+  cout << "(error \"syntax error: line " << line << " " << msg
+       << "  token: " << string(token_start, pos) << "\")" << endl;
+}
+
+void SMT2Parser::error(const string& msg)
+{
+  warn(msg);
+  throw SyntaxError();
+}
+
+void SMT2Parser::expect(Token t, const char* what)
+{
+  if (tok != t)
+    error(what);
+  next();
+}
+
+// Commands check for their closing bracket before they run, and only
+// move past it afterwards, so nothing after them is read first.
+void SMT2Parser::close()
+{
+  if (tok != T_RPAREN)
+    error("expected )");
+}
+
+// Skips to the bracket that closes the current command.
+void SMT2Parser::skipToClose()
+{
+  int depth = 0;
+  while (depth > 0 || tok != T_RPAREN)
+  {
+    if (tok == T_END)
+      error("unexpected end of input");
+    else if (tok == T_LPAREN)
+      depth++;
+    else if (tok == T_RPAREN)
+      depth--;
+    next();
+  }
+}
+
+string SMT2Parser::name()
+{
+  if (tok != T_SYMBOL || keyword != K_NONE)
+    error("expected a name");
+  const string s = text;
+  next();
+  return s;
+}
+
+unsigned SMT2Parser::readNumeral()
+{
+  if (tok != T_NUMERAL)
+    error("expected a numeral");
+  const unsigned n = numeral;
+  next();
+  return n;
+}
+
+// What smt2.lex would not have returned as a fresh name.
+bool SMT2Parser::isDeclared(const string& s)
+{
+  return pi.isSymbolAlreadyDeclared(s) || pi.letMgr->isLetDeclared(s) ||
+         pi.isBitVectorFunction(s) || pi.isBooleanFunction(s);
+}
+
+ASTVec& SMT2Parser::acquire()
+{
+  if (scratch_depth == scratch.size())
+    scratch.push_back(ASTVec());
+  return scratch[scratch_depth++];
+}
+
+// Clearing drops the references, so that symbols can go away as soon as
+// smt2.y would have let them.
+void SMT2Parser::release()
+{
+  scratch[--scratch_depth].clear();
+}
+
+/********************************************************************
+ * Commands
+ ********************************************************************/
+
+bool SMT2Parser::command()
+{
+  if (tok != T_SYMBOL)
+    error("expected a command");
+  const Keyword k = keyword;
+  next();
+
+  switch (k)
+  {
+    case K_ASSERT:
+    {
+      ASTNode f = formula();
+      close();
+      pi.AddAssert(f);
+      pi.success();
+      break;
+    }
+    case K_CHECK_SAT:
+      close();
+      pi.checkSat(pi.getAssertVector());
+      break;
+    case K_CHECK_SAT_ASSUMING:
+    case K_DECLARE_CONST:
+    case K_UNSUPPORTED_COMMAND:
+      skipToClose();
+      pi.unsupported();
+      break;
+    case K_DECLARE_FUN:
+      declareFun();
+      close();
+      pi.success();
+      break;
+    case K_DEFINE_FUN:
+      defineFun();
+      close();
+      pi.success();
+      break;
+    case K_ECHO:
+    {
+      if (tok != T_STRING && (tok != T_SYMBOL || keyword != K_NONE))
+        error("expected a string");
+      const string s = text;
+      next();
+      close();
+      cout << "\"" << s << "\"" << endl;
+      pi.success();
+      break;
+    }
+    case K_EXIT:
+      close();
+      pi.cleanUp();
+      pi.success();
+      return false;
+    case K_GET_MODEL:
+      close();
+      pi.getModel();
+      break;
+    case K_GET_VALUE:
+    {
+      expect(T_LPAREN, "expected (");
+      ASTVec& v = acquire();
+      do
+        v.push_back(expr());
+      while (tok != T_RPAREN);
+      next();
+      close();
+      pi.getValue(v);
+      release();
+      break;
+    }
+    case K_PUSH:
+    case K_POP:
+    {
+      const unsigned n = readNumeral();
+      close();
+      for (unsigned i = 0; i < n; i++)
+      {
+        if (k == K_PUSH)
+          pi.push();
+        else
+          pi.pop();
+      }
+      pi.success();
+      break;
+    }
+    case K_RESET:
+      close();
+      pi.reset();
+      pi.success();
+      break;
+    case K_SET_INFO:
+      setInfo();
+      close();
+      break;
+    case K_SET_LOGIC:
+    {
+      const string logic = name();
+      close();
+      if (logic != "QF_BV" && logic != "QF_ABV" && logic != "QF_AUFBV")
+        warn("Wrong input logic");
+      pi.success();
+      break;
+    }
+    case K_SET_OPTION:
+      setOption();
+      break;
+    default:
+      error("expected a command");
+  }
+
+  next();
+  return true;
+}
+
+void SMT2Parser::declareFun()
+{
+  const string s = name();
+  if (isDeclared(s))
+    error(s + " is already declared");
+  expect(T_LPAREN, "expected (");
+  expect(T_RPAREN, "only constants can be declared");
+
+  unsigned index_width, value_width;
+  sort(index_width, value_width);
+  if (index_width > 0 && value_width == 0)
+    FatalError(
+        "Fatal Error: parsing: BITVECTORS must be of positive length: \n");
+
+  ASTNode v = pi.LookupOrCreateSymbol(s.c_str());
+  v.SetIndexWidth(index_width);
+  v.SetValueWidth(value_width);
+  pi.addSymbol(v);
+}
+
+void SMT2Parser::defineFun()
+{
+  const string f = name();
+  if (isDeclared(f))
+    error(f + " is already declared");
+  expect(T_LPAREN, "expected (");
+
+  ASTVec& params = acquire();
+  while (tok == T_LPAREN)
+  {
+    next();
+    const string p = name();
+    if (isDeclared(p))
+      error(p + " is already declared");
+    const unsigned width = bitVectorSort();
+    expect(T_RPAREN, "expected )");
+
+    ASTNode s = pi.LookupOrCreateSymbol(p.c_str());
+    pi.addSymbol(s);
+    s.SetIndexWidth(0);
+    s.SetValueWidth(width);
+    params.push_back(s);
+  }
+  expect(T_RPAREN, "expected )");
+
+  unsigned index_width, value_width;
+  const bool is_bool = sort(index_width, value_width);
+  if (index_width > 0)
+  {
+    term();
+    pi.unsupported();
+    release();
+    return;
+  }
+
+  ASTNode body = is_bool ? formula() : term();
+  if (!is_bool && body.GetValueWidth() != value_width)
+    warn("Different bit-widths specified: " +
+         std::to_string(body.GetValueWidth()) + " " +
+         std::to_string(value_width));
+
+  pi.storeFunction(f, params, body);
+
+  // Next time the variable is used, we want it to be fresh.
+  for (size_t i = 0; i < params.size(); i++)
+    pi.removeSymbol(params[i]);
+  release();
+}
+
+void SMT2Parser::setInfo()
+{
+  if (tok != T_ATTRIBUTE)
+    error("expected an attribute");
+  const bool status = (text == "status");
+  next();
+
+  if (status)
+  {
+    if (tok != T_STRING && (tok != T_SYMBOL || keyword != K_NONE))
+      error("expected sat, unsat or unknown");
+    string s = text;
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    if (s == "sat")
+      input_status = TO_BE_SATISFIABLE;
+    else if (s == "unsat")
+      input_status = TO_BE_UNSATISFIABLE;
+    else if (s == "unknown")
+      input_status = TO_BE_UNKNOWN;
+    else
+      warn(s);
+    next();
+  }
+
+  // Any other value is ignored.
+  skipToClose();
+}
+
+void SMT2Parser::setOption()
+{
+  if (tok != T_ATTRIBUTE)
+    error("expected an option");
+  const string option = text;
+  next();
+
+  string value;
+  if (tok == T_SYMBOL && keyword == K_TRUE)
+    value = "true";
+  else if (tok == T_SYMBOL && keyword == K_FALSE)
+    value = "false";
+  else if (tok == T_STRING || (tok == T_SYMBOL && keyword == K_NONE))
+    value = text;
+  else if (tok == T_NUMERAL)
+    value = std::to_string(numeral);
+  else
+    error("expected an option value");
+  next();
+  close();
+
+  pi.setOption(option, value);
+}
+
+// Bool, (_ BitVec n) or (Array (_ BitVec n) (_ BitVec m)). Returns
+// whether it's Bool, which is 0 wide.
+bool SMT2Parser::sort(unsigned& index_width, unsigned& value_width)
+{
+  index_width = value_width = 0;
+  if (tok == T_SYMBOL && keyword == K_BOOL)
+  {
+    next();
+    return true;
+  }
+
+  expect(T_LPAREN, "expected a sort");
+  if (tok == T_SYMBOL && keyword == K_UNDERSCORE)
+  {
+    next();
+    if (tok != T_SYMBOL || keyword != K_BITVEC)
+      error("expected BitVec");
+    next();
+    value_width = readNumeral();
+  }
+  else if (tok == T_SYMBOL && keyword == K_ARRAY)
+  {
+    next();
+    index_width = bitVectorSort();
+    value_width = bitVectorSort();
+    if (index_width == 0)
+      FatalError(
+          "Fatal Error: parsing: BITVECTORS must be of positive length: \n");
+  }
+  else
+    error("expected a sort");
+  expect(T_RPAREN, "expected )");
+  return false;
+}
+
+unsigned SMT2Parser::bitVectorSort()
+{
+  expect(T_LPAREN, "expected (_ BitVec n)");
+  if (tok != T_SYMBOL || keyword != K_UNDERSCORE)
+    error("expected (_ BitVec n)");
+  next();
+  if (tok != T_SYMBOL || keyword != K_BITVEC)
+    error("expected (_ BitVec n)");
+  next();
+  const unsigned width = readNumeral();
+  expect(T_RPAREN, "expected )");
+  return width;
+}
+
+/********************************************************************
+ * Expressions
+ ********************************************************************/
+
+ASTNode SMT2Parser::expr()
+{
+  switch (tok)
+  {
+    case T_SYMBOL:
+      return atom();
+    case T_LPAREN:
+      next();
+      return application();
+    case T_HEX:
+    case T_BINARY:
+    {
+      const unsigned width = text.size() * (tok == T_HEX ? 4 : 1);
+      ASTNode n = pi.CreateBVConst(text, tok == T_HEX ? 16 : 2, width);
+      n.SetValueWidth(width);
+      next();
+      return n;
+    }
+    default:
+      error("expected a term or formula");
+  }
+  return ASTNode();
+}
+
+ASTNode SMT2Parser::formula()
+{
+  ASTNode n = expr();
+  if (n.GetType() != BOOLEAN_TYPE)
+    error("expected a formula");
+  return n;
+}
+
+ASTNode SMT2Parser::term()
+{
+  ASTNode n = expr();
+  if (n.GetType() == BOOLEAN_TYPE)
+    error("expected a term");
+  return n;
+}
+
+// Looked up in the same order as smt2.lex does.
+ASTNode SMT2Parser::atom()
+{
+  if (keyword == K_TRUE || keyword == K_FALSE)
+  {
+    const Kind k = (keyword == K_TRUE) ? TRUE : FALSE;
+    next();
+    return pi.CreateNode(k);
+  }
+  if (keyword != K_NONE)
+    error("unexpected " + text);
+
+  ASTNode n;
+  if (pi.LookupSymbol(text.c_str(), n))
+    ;
+  else if (pi.letMgr->isLetDeclared(text))
+    n = pi.letMgr->resolveLet(text);
+  else if (pi.isBitVectorFunction(text) || pi.isBooleanFunction(text))
+    n = pi.applyFunction(text, _empty_ASTVec);
+  else
+    error(text + " is not declared");
+  next();
+  return n;
+}
+
+// After an opening bracket.
+ASTNode SMT2Parser::application()
+{
+  if (tok != T_SYMBOL || keyword == K_NONE || keyword == K_TRUE ||
+      keyword == K_FALSE)
+  {
+    if (tok == T_SYMBOL && keyword == K_NONE &&
+        !pi.isSymbolAlreadyDeclared(text) &&
+        !pi.letMgr->isLetDeclared(text) &&
+        (pi.isBitVectorFunction(text) || pi.isBooleanFunction(text)))
+    {
+      const string f = text;
+      next();
+      ASTVec& args = acquire();
+      while (tok != T_RPAREN)
+        args.push_back(expr());
+      next();
+      ASTNode n = pi.applyFunction(f, args);
+      release();
+      return n;
+    }
+
+    // smt2.y allows brackets around anything.
+    ASTNode n = expr();
+    expect(T_RPAREN, "expected )");
+    return n;
+  }
+
+  const Keyword k = keyword;
+  next();
+
+  NodeFactory* nf = pi.nf;
+  ASTNode n;
+  switch (k)
+  {
+    case K_UNDERSCORE:
+      return indexed();
+    case K_BANG:
+      return named();
+    case K_LET:
+      return let();
+    case K_DISTINCT:
+      return distinct();
+
+    case K_NOT:
+      n = nf->CreateNode(NOT, formula());
+      break;
+    case K_IMPLIES:
+    case K_XOR:
+    {
+      ASTNode a = formula();
+      ASTNode b = formula();
+      n = pi.CreateNode(k == K_IMPLIES ? IMPLIES : XOR, a, b);
+      break;
+    }
+    case K_AND:
+    case K_OR:
+    {
+      ASTVec& v = acquire();
+      do
+        v.push_back(formula());
+      while (tok != T_RPAREN);
+      n = pi.CreateNode(k == K_AND ? AND : OR, v);
+      release();
+      break;
+    }
+    case K_EQ:
+    {
+      ASTNode a = expr();
+      if (a.GetType() == BOOLEAN_TYPE)
+      {
+        ASTNode b = formula();
+        n = pi.CreateNode(IFF, a, b);
+      }
+      else
+      {
+        ASTNode b = term();
+        n = pi.CreateNode(EQ, a, b);
+      }
+      break;
+    }
+    case K_ITE:
+    {
+      ASTNode c = formula();
+      ASTNode a = expr();
+      if (a.GetType() == BOOLEAN_TYPE)
+      {
+        ASTNode b = formula();
+        n = nf->CreateNode(ITE, c, a, b);
+      }
+      else
+      {
+        ASTNode b = term();
+        n = nf->CreateArrayTerm(ITE, b.GetIndexWidth(), a.GetValueWidth(), c,
+                                a, b);
+      }
+      break;
+    }
+
+    case K_BVULT:
+      n = comparison(BVLT);
+      break;
+    case K_BVUGT:
+      n = comparison(BVGT);
+      break;
+    case K_BVULE:
+      n = comparison(BVLE);
+      break;
+    case K_BVUGE:
+      n = comparison(BVGE);
+      break;
+    case K_BVSLT:
+      n = comparison(BVSLT);
+      break;
+    case K_BVSGT:
+      n = comparison(BVSGT);
+      break;
+    case K_BVSLE:
+      n = comparison(BVSLE);
+      break;
+    case K_BVSGE:
+      n = comparison(BVSGE);
+      break;
+
+    case K_SELECT:
+    {
+      ASTNode array = term();
+      ASTNode index = term();
+      n = nf->CreateTerm(READ, array.GetValueWidth(), array, index);
+      break;
+    }
+    case K_STORE:
+    {
+      ASTNode array = term();
+      ASTNode index = term();
+      ASTNode value = term();
+      n = nf->CreateArrayTerm(WRITE, array.GetIndexWidth(),
+                              value.GetValueWidth(), array, index, value);
+      break;
+    }
+
+    case K_CONCAT:
+    {
+      ASTNode a = term();
+      ASTNode b = term();
+      n = nf->CreateTerm(BVCONCAT, a.GetValueWidth() + b.GetValueWidth(), a,
+                         b);
+      break;
+    }
+    case K_BVNOT:
+    case K_BVNEG:
+    {
+      ASTNode a = term();
+      n = nf->CreateTerm(k == K_BVNOT ? BVNOT : BVUMINUS, a.GetValueWidth(),
+                         a);
+      break;
+    }
+    case K_BVAND:
+      n = binaryTerm(BVAND);
+      break;
+    case K_BVOR:
+      n = binaryTerm(BVOR);
+      break;
+    case K_BVXOR:
+      n = binaryTerm(BVXOR);
+      break;
+    case K_BVSUB:
+      n = binaryTerm(BVSUB);
+      break;
+    case K_BVADD:
+      n = binaryTerm(BVPLUS);
+      break;
+    case K_BVMUL:
+      n = binaryTerm(BVMULT);
+      break;
+    case K_BVUDIV:
+      n = binaryTerm(BVDIV);
+      break;
+    case K_BVUREM:
+      n = binaryTerm(BVMOD);
+      break;
+    case K_BVSDIV:
+      n = binaryTerm(SBVDIV);
+      break;
+    case K_BVSREM:
+      n = binaryTerm(SBVREM);
+      break;
+    case K_BVSMOD:
+      n = binaryTerm(SBVMOD);
+      break;
+    case K_BVSHL:
+      n = binaryTerm(BVLEFTSHIFT);
+      break;
+    case K_BVLSHR:
+      n = binaryTerm(BVRIGHTSHIFT);
+      break;
+    case K_BVASHR:
+      n = binaryTerm(BVSRSHIFT);
+      break;
+
+    case K_BVNAND:
+    case K_BVNOR:
+    {
+      ASTNode a = term();
+      ASTNode b = term();
+      const unsigned width = a.GetValueWidth();
+      n = nf->CreateTerm(
+          BVNOT, width,
+          nf->CreateTerm(k == K_BVNAND ? BVAND : BVOR, width, a, b));
+      break;
+    }
+    case K_BVXNOR:
+    {
+      // (bvxnor s t) abbreviates (bvor (bvand s t) (bvand (bvnot s) (bvnot t)))
+      ASTNode a = term();
+      ASTNode b = term();
+      const unsigned width = a.GetValueWidth();
+      ASTNode both = nf->CreateTerm(BVAND, width, a, b);
+      ASTNode neither =
+          nf->CreateTerm(BVAND, width, nf->CreateTerm(BVNOT, width, a),
+                         nf->CreateTerm(BVNOT, width, b));
+      n = nf->CreateTerm(BVOR, width, both, neither);
+      break;
+    }
+    case K_BVCOMP:
+    {
+      ASTNode a = term();
+      ASTNode b = term();
+      n = nf->CreateTerm(ITE, 1, nf->CreateNode(EQ, a, b),
+                         pi.CreateOneConst(1), pi.CreateZeroConst(1));
+      break;
+    }
+
+    default:
+      error("unexpected operator");
+  }
+
+  expect(T_RPAREN, "expected )");
+  return n;
+}
+
+ASTNode SMT2Parser::binaryTerm(Kind k)
+{
+  ASTNode a = term();
+  ASTNode b = term();
+  return pi.nf->CreateTerm(k, a.GetValueWidth(), a, b);
+}
+
+ASTNode SMT2Parser::comparison(Kind k)
+{
+  ASTNode a = term();
+  ASTNode b = term();
+  return pi.CreateNode(k, a, b);
+}
+
+// After "(_". Either a (_ bvN w) constant, or an indexed operator, which
+// smt2.y applies to the term that follows its closing bracket.
+ASTNode SMT2Parser::indexed()
+{
+  const Keyword k = keyword;
+  if (tok == T_SYMBOL && k == K_BV_CONST)
+  {
+    string digits = text.substr(2);
+    next();
+    const unsigned width = readNumeral();
+    expect(T_RPAREN, "expected )");
+    ASTNode n = pi.CreateBVConst(digits, 10, width);
+    n.SetValueWidth(width);
+    return n;
+  }
+
+  if (tok != T_SYMBOL ||
+      (k != K_EXTRACT && k != K_ZERO_EXTEND && k != K_SIGN_EXTEND &&
+       k != K_REPEAT && k != K_ROTATE_LEFT && k != K_ROTATE_RIGHT))
+    error("expected an indexed operator");
+  next();
+  const unsigned i = readNumeral();
+  const unsigned j = (k == K_EXTRACT) ? readNumeral() : 0;
+  expect(T_RPAREN, "expected )");
+
+  ASTNode t = term();
+  NodeFactory* nf = pi.nf;
+  switch (k)
+  {
+    case K_EXTRACT:
+    {
+      const int width = i - j + 1;
+      if (width < 0)
+        warn("Negative width in extract");
+      if (i >= t.GetValueWidth())
+        warn("Parsing: Wrong width in BVEXTRACT\n");
+
+      ASTNode hi = pi.CreateBVConst(32, i);
+      ASTNode low = pi.CreateBVConst(32, j);
+      return nf->CreateTerm(BVEXTRACT, width, t, hi, low);
+    }
+    case K_ZERO_EXTEND:
+    case K_SIGN_EXTEND:
+    {
+      const unsigned w = t.GetValueWidth() + i;
+      ASTNode width = pi.CreateBVConst(32, w);
+      return nf->CreateTerm(k == K_ZERO_EXTEND ? BVZX : BVSX, w, t, width);
+    }
+    case K_REPEAT:
+    {
+      if (i < 1)
+        FatalError("One or more repeats please");
+      const unsigned w = t.GetValueWidth();
+      ASTNode n = t;
+      for (unsigned c = 1; c < i; c++)
+        n = nf->CreateTerm(BVCONCAT, w * (c + 1), n, t);
+      return n;
+    }
+    default:
+    {
+      // Rotations, as the concatenation of two extracts, split where the
+      // low bits of the result come from.
+      const unsigned width = t.GetValueWidth();
+      const unsigned rotate = i % width;
+      if (rotate == 0)
+        return t;
+
+      const unsigned split = (k == K_ROTATE_LEFT) ? width - rotate : rotate;
+      ASTNode high = pi.CreateBVConst(32, width - 1);
+      ASTNode zero = pi.CreateBVConst(32, 0);
+      ASTNode cut = pi.CreateBVConst(32, split);
+      ASTNode cutMinusOne = pi.CreateBVConst(32, split - 1);
+
+      ASTNode top = nf->CreateTerm(BVEXTRACT, width - split, t, high, cut);
+      ASTNode bottom = nf->CreateTerm(BVEXTRACT, split, t, cutMinusOne, zero);
+      return nf->CreateTerm(BVCONCAT, width, bottom, top);
+    }
+  }
+}
+
+// (! e :named foo) asserts that foo, a new symbol, equals e.
+ASTNode SMT2Parser::named()
+{
+  ASTNode e = expr();
+  if (tok != T_ATTRIBUTE || text != "named")
+    error("expected :named");
+  next();
+  const string s = name();
+  expect(T_RPAREN, "expected )");
+
+  ASTNode v = pi.LookupOrCreateSymbol(s.c_str());
+  v.SetIndexWidth(e.GetIndexWidth());
+  v.SetValueWidth(e.GetValueWidth());
+  pi.addSymbol(v);
+  pi.AddAssert(pi.CreateNode(e.GetType() == BOOLEAN_TYPE ? IFF : EQ, v, e));
+  return e;
+}
+
+// As in smt2.y the bindings are made one after the other, and can't
+// shadow a name that's already in scope.
+ASTNode SMT2Parser::let()
+{
+  expect(T_LPAREN, "expected (");
+  pi.letMgr->push();
+  do
+  {
+    expect(T_LPAREN, "expected a binding");
+    const string s = name();
+    if (isDeclared(s))
+      error(s + " is already declared");
+    ASTNode value = expr();
+    expect(T_RPAREN, "expected )");
+    pi.letMgr->LetExprMgr(s, value);
+  } while (tok != T_RPAREN);
+  next();
+
+  ASTNode body = expr();
+  pi.letMgr->pop();
+  expect(T_RPAREN, "expected )");
+  return body;
+}
+
+ASTNode SMT2Parser::distinct()
+{
+  ASTVec& args = acquire();
+  do
+    args.push_back(expr());
+  while (tok != T_RPAREN);
+
+  const bool formulas = (args[0].GetType() == BOOLEAN_TYPE);
+  for (size_t i = 1; i < args.size(); i++)
+    if ((args[i].GetType() == BOOLEAN_TYPE) != formulas)
+      error("distinct mixes terms and formulas");
+
+  ASTVec& forms = acquire();
+  for (size_t i = 0; i < args.size(); i++)
+    for (size_t j = i + 1; j < args.size(); j++)
+      forms.push_back(pi.nf->CreateNode(
+          NOT, pi.CreateNode(formulas ? IFF : EQ, args[i], args[j])));
+
+  if (forms.size() == 0)
+    FatalError("empty distinct");
+
+  ASTNode n = (forms.size() == 1) ? forms[0] : pi.CreateNode(AND, forms);
+  release();
+  release();
+  expect(T_RPAREN, "expected )");
+  return n;
+}
+} // end namespace stp
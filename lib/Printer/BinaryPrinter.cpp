@@ -0,0 +1,134 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/Printer/printers.h"
+#include "stp/Printer/BinaryFormat.h"
+#include "extlib-constbv/constantbv.h"
+#include <unordered_map>
+#include <utility>
+
+namespace printer
+{
+using std::string;
+using namespace stp;
+
+// Children are numbered before their parents. The DAG is walked with an
+// explicit stack, as formulas can be far deeper than the C++ stack allows.
+void Binary_Print(string& out, const ASTNode& root)
+{
+  std::unordered_map<unsigned, uint32_t> nodeIndex;
+  std::unordered_map<unsigned, uint32_t> symbolIndex;
+  ASTVec nodes;
+  ASTVec symbols;
+
+  std::vector<std::pair<ASTNode, size_t> > stack;
+  stack.push_back(std::make_pair(root, 0));
+  while (!stack.empty())
+  {
+    const ASTNode n = stack.back().first;
+    const size_t child = stack.back().second;
+
+    if (child == 0 && nodeIndex.find(n.GetNodeNum()) != nodeIndex.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if (child < n.Degree())
+    {
+      stack.back().second++;
+      if (nodeIndex.find(n[child].GetNodeNum()) == nodeIndex.end())
+        stack.push_back(std::make_pair(n[child], 0));
+      continue;
+    }
+
+    stack.pop_back();
+    if (n.GetKind() == SYMBOL)
+    {
+      symbolIndex.insert(std::make_pair(n.GetNodeNum(), symbols.size()));
+      symbols.push_back(n);
+    }
+    nodeIndex.insert(std::make_pair(n.GetNodeNum(), nodes.size()));
+    nodes.push_back(n);
+  }
+
+  out.append(binary::MAGIC, sizeof(binary::MAGIC));
+  binary::putU32(out, binary::VERSION);
+
+  binary::putU32(out, symbols.size());
+  for (size_t i = 0; i < symbols.size(); i++)
+  {
+    const char* name = symbols[i].GetName();
+    const size_t length = strlen(name);
+    binary::putU32(out, length);
+    out.append(name, length);
+  }
+
+  binary::putU32(out, nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    const ASTNode& n = nodes[i];
+    const Kind k = n.GetKind();
+    out.push_back((char)k);
+    binary::putU32(out, n.GetValueWidth());
+    binary::putU32(out, n.GetIndexWidth());
+
+    switch (k)
+    {
+      case SYMBOL:
+        binary::putU32(out, symbolIndex[n.GetNodeNum()]);
+        break;
+      case BVCONST:
+      {
+        const unsigned width = n.GetValueWidth();
+        CBV bv = n.GetBVConst();
+        for (unsigned bit = 0; bit < width; bit += 8)
+        {
+          const unsigned chunk = (width - bit < 8) ? width - bit : 8;
+          out.push_back(
+              (char)CONSTANTBV::BitVector_Chunk_Read(bv, chunk, bit));
+        }
+        break;
+      }
+      case TRUE:
+      case FALSE:
+      case UNDEFINED:
+        break;
+      default:
+        binary::putU32(out, n.Degree());
+        for (size_t c = 0; c < n.Degree(); c++)
+          binary::putU32(out, nodeIndex[n[c].GetNodeNum()]);
+    }
+  }
+}
+
+ostream& Binary_Print(ostream& os, const ASTNode& n)
+{
+  string out;
+  Binary_Print(out, n);
+  os.write(out.data(), out.size());
+  return os;
+}
+}
@@ -30,7 +30,7 @@ namespace printer
 using std::string;
 using namespace stp;
 
-ASTNodeSet Lisp_AlreadyPrintedSet;
+thread_local ASTNodeSet Lisp_AlreadyPrintedSet;
 ostream& Lisp_Print_indent(ostream& os, const ASTNode& n, int indentation);
 
 /** Internal function to print in lisp format.  Assume newline
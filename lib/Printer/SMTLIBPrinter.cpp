@@ -42,15 +42,15 @@ static string tolower(const char* name)
 }
 
 // Map from ASTNodes to LetVars
-stp::ASTNodeMap NodeLetVarMap;
+thread_local stp::ASTNodeMap NodeLetVarMap;
 
 // This is a vector which stores the Node to LetVars pairs. It
 // allows for sorted printing, as opposed to NodeLetVarMap
-vector<pair<ASTNode, ASTNode>> NodeLetVarVec;
+thread_local vector<pair<ASTNode, ASTNode>> NodeLetVarVec;
 
 // a partial Map from ASTNodes to LetVars. Needed in order to
 // correctly print shared subterms inside the LET itself
-stp::ASTNodeMap NodeLetVarMap1;
+thread_local stp::ASTNodeMap NodeLetVarMap1;
 
 // copied from Presentation Langauge printer.
 ostream& SMTLIB_Print(ostream& os, STPMgr *mgr, const ASTNode n, const int indentation,
@@ -0,0 +1,202 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/STP.h"
+#include <algorithm>
+#include <map>
+
+namespace stp
+{
+
+namespace
+{
+
+void flattenAnd(const ASTNode& n, ASTVec& conjuncts)
+{
+  if (n.GetKind() == AND)
+  {
+    for (size_t i = 0; i < n.Degree(); i++)
+      flattenAnd(n[i], conjuncts);
+  }
+  else if (n.GetKind() != TRUE)
+    conjuncts.push_back(n);
+}
+
+struct Slice
+{
+  ASTVec conjuncts;
+  ASTVec symbols;
+};
+
+// Groups the conjuncts so that no symbol is in two groups. The groups are
+// in the order of their first conjunct.
+void partition(const ASTVec& conjuncts, vector<Slice>& slices)
+{
+  const size_t n = conjuncts.size();
+  vector<size_t> parent(n);
+  for (size_t i = 0; i < n; i++)
+    parent[i] = i;
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+
+  // Each node belongs to the first conjunct it's found under. Meeting it
+  // again from another conjunct joins the two.
+  std::unordered_map<ASTNode, size_t, ASTNode::ASTNodeHasher,
+                     ASTNode::ASTNodeEqual> owner;
+  ASTVec symbols;
+  for (size_t i = 0; i < n; i++)
+  {
+    ASTVec stack(1, conjuncts[i]);
+    while (!stack.empty())
+    {
+      const ASTNode node = stack.back();
+      stack.pop_back();
+      if (node.isConstant())
+        continue;
+
+      auto it = owner.find(node);
+      if (it != owner.end())
+      {
+        const size_t a = find(it->second), b = find(i);
+        parent[std::max(a, b)] = std::min(a, b);
+        continue;
+      }
+      owner.insert(std::make_pair(node, i));
+      if (node.GetKind() == SYMBOL)
+        symbols.push_back(node);
+
+      const ASTVec& c = node.GetChildren();
+      stack.insert(stack.end(), c.begin(), c.end());
+    }
+  }
+
+  std::map<size_t, size_t> slice_of;
+  for (size_t i = 0; i < n; i++)
+  {
+    const size_t root = find(i);
+    if (slice_of.find(root) == slice_of.end())
+    {
+      slice_of[root] = slices.size();
+      slices.push_back(Slice());
+    }
+    slices[slice_of[root]].conjuncts.push_back(conjuncts[i]);
+  }
+  for (size_t i = 0; i < symbols.size(); i++)
+    slices[slice_of[find(owner[symbols[i]])]].symbols.push_back(symbols[i]);
+}
+}
+
+// Each slice is solved by TopLevelSTP on its own, so with the query cache
+// on, slices that earlier queries had too are answered from it. The slice
+// with the query in it goes first, because it's the one most likely to
+// make the whole thing unsatisfiable.
+bool STP::solve_by_slices(const ASTNode& inputasserts, const ASTNode& query,
+                          SOLVER_RETURN_TYPE& result)
+{
+  ASTVec conjuncts;
+  if (query != bm->ASTFalse)
+    flattenAnd(bm->CreateNode(NOT, query), conjuncts);
+  flattenAnd(inputasserts, conjuncts);
+
+  vector<Slice> slices;
+  partition(conjuncts, slices);
+  if (slices.size() < 2)
+    return false;
+
+  if (bm->UserFlags.stats_flag)
+    std::cerr << "Independence slicing: " << slices.size() << " slices."
+              << std::endl;
+
+  UserDefinedFlags& flags = bm->UserFlags;
+  UserDefinedFlags saved;
+  saved = flags;
+  const long start = Deadline::now();
+
+  // The models of the slices are put together, checked and printed at
+  // the end.
+  flags.independence_slicing = false;
+  flags.check_counterexample_flag =
+      flags.check_counterexample_flag || flags.print_counterexample_flag;
+  flags.print_counterexample_flag = false;
+
+  vector<std::pair<ASTNode, ASTNode> > model;
+  result = SOLVER_INVALID;
+  for (size_t i = 0; i < slices.size() && result == SOLVER_INVALID; i++)
+  {
+    if (saved.timeout_max_time >= 0)
+    {
+      flags.timeout_max_time = std::max<int64_t>(
+          0, saved.timeout_max_time - (Deadline::now() - start));
+    }
+
+    ClearAllTables();
+    const ASTVec& c = slices[i].conjuncts;
+    result = TopLevelSTP(c.size() == 1 ? c[0] : bm->CreateNode(AND, c),
+                         bm->ASTFalse);
+
+    if (result == SOLVER_INVALID && flags.construct_counterexample_flag)
+    {
+      // GetCounterExample returns nothing if this is left over from a
+      // valid query.
+      bm->ValidFlag = false;
+      for (size_t j = 0; j < slices[i].symbols.size(); j++)
+      {
+        const ASTNode& s = slices[i].symbols[j];
+        model.push_back(std::make_pair(s, Ctr_Example->GetCounterExample(s)));
+      }
+    }
+  }
+
+  const bool construct = flags.construct_counterexample_flag;
+  flags = saved;
+  flags.construct_counterexample_flag = construct;
+
+  if (result != SOLVER_INVALID)
+    return true;
+
+  ClearAllTables();
+  for (size_t i = 0; i < model.size(); i++)
+    if (model[i].second.isConstant())
+      Ctr_Example->SetCounterExample(model[i].first, model[i].second);
+
+  if (construct)
+  {
+    const ASTNode all = bm->CreateNode(AND, conjuncts);
+    if (flags.check_counterexample_flag &&
+        Ctr_Example->ComputeFormulaUsingModel(all) != bm->ASTTrue)
+      FatalError("Independence slicing: the model doesn't satisfy the input");
+
+    if (flags.print_counterexample_flag)
+    {
+      Ctr_Example->PrintCounterExample(true);
+      Ctr_Example->PrintCounterExample_InOrder(true);
+    }
+  }
+  return true;
+}
+}
@@ -0,0 +1,86 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/STP.h"
+
+namespace stp
+{
+
+// Symbols that the earlier queries didn't have get whatever value
+// ComputeFormulaUsingModel gives them, which is as good as any other.
+bool STP::tryRecentModels(const ASTNode& original_input)
+{
+  for (std::list<Model>::iterator it = recentModels.begin();
+       it != recentModels.end(); it++)
+  {
+    Ctr_Example->ClearCounterExampleMap();
+    Ctr_Example->ClearComputeFormulaMap();
+    for (size_t i = 0; i < it->size(); i++)
+      Ctr_Example->SetCounterExample((*it)[i].first, (*it)[i].second);
+
+    if (Ctr_Example->ComputeFormulaUsingModel(original_input) != bm->ASTTrue)
+      continue;
+
+    recentModels.splice(recentModels.begin(), recentModels, it);
+    bm->GetRunTimes()->addCount(RunTimes::ModelReuseHit);
+
+    if (bm->UserFlags.print_counterexample_flag)
+    {
+      Ctr_Example->PrintCounterExample(true);
+      Ctr_Example->PrintCounterExample_InOrder(true);
+    }
+    return true;
+  }
+
+  Ctr_Example->ClearCounterExampleMap();
+  Ctr_Example->ClearComputeFormulaMap();
+  bm->GetRunTimes()->addCount(RunTimes::ModelReuseMiss);
+  return false;
+}
+
+void STP::rememberModel(const ASTNode& original_input)
+{
+  ASTNodeSet visited, symbols;
+  buildListOfSymbols(original_input, visited, symbols);
+
+  // GetCounterExample returns nothing if this is left over from a valid
+  // query.
+  bm->ValidFlag = false;
+
+  Model model;
+  for (ASTNodeSet::const_iterator it = symbols.begin(); it != symbols.end();
+       it++)
+  {
+    const ASTNode value = Ctr_Example->GetCounterExample(*it);
+    if (!value.isConstant())
+      return;
+    model.push_back(std::make_pair(*it, value));
+  }
+
+  recentModels.push_front(model);
+  while (recentModels.size() > (size_t)bm->UserFlags.model_reuse_size)
+    recentModels.pop_back();
+}
+}
@@ -0,0 +1,275 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/STP.h"
+#include "extlib-abc/cnf_short.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace stp
+{
+
+namespace
+{
+
+// Raised once one of the solvers has a definite answer.
+class PortfolioCancellation : public Cancellation
+{
+public:
+  std::atomic<bool> raised;
+
+  PortfolioCancellation() : raised(false) {}
+
+  bool requested() const { return raised.load(std::memory_order_relaxed); }
+};
+
+const int num_configurations = 8;
+
+UserDefinedFlags::SATSolvers otherSolver(UserDefinedFlags::SATSolvers s)
+{
+#ifdef USE_CRYPTOMINISAT
+  return (s == UserDefinedFlags::CRYPTOMINISAT5_SOLVER)
+             ? UserDefinedFlags::MINISAT_SOLVER
+             : UserDefinedFlags::CRYPTOMINISAT5_SOLVER;
+#else
+  return (s == UserDefinedFlags::SIMPLIFYING_MINISAT_SOLVER)
+             ? UserDefinedFlags::MINISAT_SOLVER
+             : UserDefinedFlags::SIMPLIFYING_MINISAT_SOLVER;
+#endif
+}
+
+// Each configuration changes the caller's settings in a way that sometimes
+// makes a big difference to the solving time.
+void configure(UserDefinedFlags& flags, int configuration)
+{
+  switch (configuration)
+  {
+    case 0: // As the caller asked.
+      break;
+    case 1:
+      flags.disableSimplifications();
+      break;
+    case 2: // Ackermannisation instead of refinement, or the other way.
+      flags.ackermannisation = !flags.ackermannisation;
+      break;
+    case 3:
+      flags.solver_to_use = otherSolver(flags.solver_to_use);
+      break;
+    case 4:
+      flags.multiplication_variant = "3";
+      break;
+    case 5:
+      flags.multiplication_variant = "1";
+      break;
+    case 6:
+      flags.disableSimplifications();
+      flags.solver_to_use = otherSolver(flags.solver_to_use);
+      break;
+    case 7:
+      flags.ackermannisation = !flags.ackermannisation;
+      flags.multiplication_variant = "9";
+      break;
+    default:
+      FatalError("Portfolio: unknown configuration");
+  }
+}
+
+// A complete STP of its own. Nodes can't be shared between threads, so
+// each works on its own copy of the query.
+struct Worker
+{
+  std::unique_ptr<STPMgr> mgr;
+  std::unique_ptr<SimplifyingNodeFactory> nf;
+  std::unique_ptr<STP> stp;
+  ASTNode input;
+  SOLVER_RETURN_TYPE result;
+
+  Worker() : mgr(new STPMgr()), result(SOLVER_UNDECIDED)
+  {
+    nf.reset(new SimplifyingNodeFactory(*mgr->hashingNodeFactory, *mgr));
+    mgr->defaultNodeFactory = nf.get();
+
+    Simplifier* simp = new Simplifier(mgr.get());
+    ArrayTransformer* at = new ArrayTransformer(mgr.get(), simp);
+    AbsRefine_CounterExample* abs =
+        new AbsRefine_CounterExample(mgr.get(), simp, at);
+    stp.reset(new STP(mgr.get(), simp, at, new ToSAT(mgr.get()), abs));
+  }
+
+  ~Worker()
+  {
+    input = ASTNode();
+    stp->deleteObjects();
+    stp.reset();
+    mgr->defaultNodeFactory = mgr->hashingNodeFactory;
+    nf.reset();
+  }
+};
+}
+
+// The caller's STPMgr is only used from this thread. Its nodes are copied
+// into each worker before the threads start, and the winner's model is
+// copied back after they have all finished.
+SOLVER_RETURN_TYPE STP::solve_by_portfolio(const ASTNode& original_input)
+{
+  const int threads =
+      std::min(bm->UserFlags.portfolio_threads, num_configurations);
+
+  PortfolioCancellation cancellation;
+  std::atomic<int> winner(-1);
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  for (int i = 0; i < threads; i++)
+  {
+    Worker* w = new Worker();
+    workers.push_back(std::unique_ptr<Worker>(w));
+
+    w->mgr->UserFlags = bm->UserFlags;
+    UserDefinedFlags& flags = w->mgr->UserFlags;
+    configure(flags, i);
+    flags.portfolio_threads = 0;
+    flags.bitblast_threads = 0;
+    flags.independence_slicing = false;
+    flags.query_cache_size = 0;
+    flags.query_cache_file.clear();
+    flags.incremental_solving = false;
+
+    // Only the answer gets reported, and that's by the caller, who also
+    // keeps the model for reuse.
+    flags.check_counterexample_flag = flags.check_counterexample_flag ||
+                                      flags.print_counterexample_flag ||
+                                      flags.model_reuse_size > 0;
+    flags.model_reuse_size = 0;
+    flags.unsat_core_cache_size = 0;
+    flags.print_counterexample_flag = false;
+    flags.print_output_flag = false;
+    flags.stats_flag = false;
+    flags.quick_statistics_flag = false;
+    flags.output_CNF_flag = false;
+    flags.output_bench_flag = false;
+
+    w->mgr->deadline.setCancellation(&cancellation);
+
+    ASTNodeMap copied;
+    w->input = w->mgr->ImportNode(original_input, copied);
+  }
+
+  std::vector<std::thread> running;
+  for (int i = 0; i < threads; i++)
+  {
+    Worker* w = workers[i].get();
+    running.push_back(std::thread([w, i, &winner, &cancellation]() {
+      try
+      {
+        w->result = w->stp->TopLevelSTP(w->input, w->mgr->ASTFalse);
+      }
+      catch (...)
+      {
+        w->result = SOLVER_ERROR;
+      }
+
+      if (w->result == SOLVER_VALID || w->result == SOLVER_INVALID)
+      {
+        int none = -1;
+        if (winner.compare_exchange_strong(none, i))
+          cancellation.raised = true;
+      }
+
+      // The thread's CNF tables go with it.
+      Cnf_ClearMemory();
+    }));
+  }
+
+  for (size_t i = 0; i < running.size(); i++)
+    running[i].join();
+
+  if (winner == -1)
+  {
+    for (int i = 0; i < threads; i++)
+      if (workers[i]->result == SOLVER_TIMEOUT)
+      {
+        bm->soft_timeout_expired = true;
+        return SOLVER_TIMEOUT;
+      }
+    return workers[0]->result;
+  }
+
+  Worker& w = *workers[winner];
+  if (bm->UserFlags.stats_flag)
+    std::cerr << "Portfolio: configuration " << winner << " answered first."
+              << std::endl;
+
+  // The winner decides, as TopLevelSTPAux does, whether it needs a model.
+  if (w.result == SOLVER_INVALID &&
+      w.mgr->UserFlags.construct_counterexample_flag)
+  {
+    Ctr_Example->ClearCounterExampleMap();
+    AbsRefine_CounterExample* model = w.stp->Ctr_Example;
+
+    ASTNodeMap copied;
+    ASTNodeSet visited, symbols;
+    buildListOfSymbols(original_input, visited, symbols);
+    for (ASTNodeSet::const_iterator it = symbols.begin(); it != symbols.end();
+         it++)
+    {
+      const ASTNode& s = *it;
+      const ASTNode theirs = w.mgr->hashingNodeFactory->CreateSymbol(
+          s.GetName(), s.GetIndexWidth(), s.GetValueWidth());
+
+      if (s.GetType() == ARRAY_TYPE)
+      {
+        vector<std::pair<ASTNode, ASTNode>> entries =
+            model->GetCounterExampleArray(true, theirs);
+        for (size_t j = 0; j < entries.size(); j++)
+        {
+          const ASTNode index = bm->ImportNode(entries[j].first, copied);
+          Ctr_Example->SetCounterExample(
+              bm->CreateTerm(READ, s.GetValueWidth(), s, index),
+              bm->ImportNode(entries[j].second, copied));
+        }
+      }
+      else
+      {
+        Ctr_Example->SetCounterExample(
+            s, bm->ImportNode(model->GetCounterExample(theirs), copied));
+      }
+    }
+
+    if (bm->UserFlags.check_counterexample_flag &&
+        Ctr_Example->ComputeFormulaUsingModel(original_input) != bm->ASTTrue)
+      FatalError("Portfolio: the winning model doesn't satisfy the input");
+
+    if (bm->UserFlags.print_counterexample_flag)
+    {
+      Ctr_Example->PrintCounterExample(true);
+      Ctr_Example->PrintCounterExample_InOrder(true);
+    }
+  }
+
+  return w.result;
+}
+}
@@ -0,0 +1,366 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/QueryCache.h"
+#include "stp/STPManager/QueryCacheFile.h"
+#include "stp/STPManager/STP.h"
+#include <algorithm>
+
+namespace stp
+{
+
+namespace
+{
+
+typedef std::unordered_map<ASTNode, uint64_t, ASTNode::ASTNodeHasher,
+                           ASTNode::ASTNodeEqual> ASTNodeToWord;
+
+uint64_t mix(uint64_t h, uint64_t v)
+{
+  h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  return h;
+}
+
+// The value of a constant, 32 bits at a time, lowest first.
+void constantChunks(const ASTNode& n, std::vector<unsigned>& chunks)
+{
+  const unsigned width = n.GetValueWidth();
+  CBV cbv = n.GetBVConst();
+  for (unsigned offset = 0; offset < width; offset += 32)
+    chunks.push_back(
+        (unsigned)CONSTANTBV::BitVector_Chunk_Read(cbv, 32, offset));
+}
+
+// A hash of the shape of n, which doesn't depend on the names of its
+// symbols, or the order of the children of commutative operations.
+uint64_t shapeHash(const ASTNode& n, ASTNodeToWord& memo)
+{
+  ASTNodeToWord::const_iterator it = memo.find(n);
+  if (it != memo.end())
+    return it->second;
+
+  uint64_t h = mix(mix(n.GetKind(), n.GetValueWidth()), n.GetIndexWidth());
+  if (n.GetKind() == BVCONST)
+  {
+    std::vector<unsigned> chunks;
+    constantChunks(n, chunks);
+    for (size_t i = 0; i < chunks.size(); i++)
+      h = mix(h, chunks[i]);
+  }
+  else if (n.GetKind() != SYMBOL)
+  {
+    std::vector<uint64_t> children;
+    for (size_t i = 0; i < n.Degree(); i++)
+      children.push_back(shapeHash(n[i], memo));
+    if (isCommutative(n.GetKind()))
+      std::sort(children.begin(), children.end());
+    for (size_t i = 0; i < children.size(); i++)
+      h = mix(h, children[i]);
+  }
+
+  memo.insert(std::make_pair(n, h));
+  return h;
+}
+
+struct ByShape
+{
+  ASTNodeToWord& shapes;
+  explicit ByShape(ASTNodeToWord& s) : shapes(s) {}
+  bool operator()(const ASTNode& a, const ASTNode& b) const
+  {
+    return shapes.find(a)->second < shapes.find(b)->second;
+  }
+};
+
+// Appends n to the canonical form after its children, and returns its
+// position. Each node is written as its kind and widths followed by,
+// for constants, the number of chunks and the chunks, and for other
+// non-symbols, the number of children and their positions.
+uint64_t serialise(const ASTNode& n, ASTNodeToWord& shapes,
+                   ASTNodeToWord& positions, uint64_t& next,
+                   std::vector<uint64_t>& words, ASTVec& symbols)
+{
+  ASTNodeToWord::const_iterator it = positions.find(n);
+  if (it != positions.end())
+    return it->second;
+
+  std::vector<uint64_t> children;
+  if (n.Degree() > 0)
+  {
+    ASTVec c = n.GetChildren();
+    if (isCommutative(n.GetKind()))
+      std::stable_sort(c.begin(), c.end(), ByShape(shapes));
+    for (size_t i = 0; i < c.size(); i++)
+      children.push_back(
+          serialise(c[i], shapes, positions, next, words, symbols));
+  }
+
+  words.push_back(n.GetKind());
+  words.push_back(n.GetValueWidth());
+  words.push_back(n.GetIndexWidth());
+  if (n.GetKind() == SYMBOL)
+  {
+    symbols.push_back(n);
+  }
+  else if (n.GetKind() == BVCONST)
+  {
+    std::vector<unsigned> chunks;
+    constantChunks(n, chunks);
+    words.push_back(chunks.size());
+    words.insert(words.end(), chunks.begin(), chunks.end());
+  }
+  else
+  {
+    words.push_back(children.size());
+    words.insert(words.end(), children.begin(), children.end());
+  }
+
+  const uint64_t position = next++;
+  positions.insert(std::make_pair(n, position));
+  return position;
+}
+}
+
+QueryCache::QueryCache(size_t c) : capacity(c)
+{
+}
+
+void QueryCache::makeKey(const ASTNode& query, Key& key, ASTVec& symbols)
+{
+  key.words.clear();
+  symbols.clear();
+
+  ASTNodeToWord shapes;
+  shapeHash(query, shapes);
+
+  ASTNodeToWord positions;
+  uint64_t next = 0;
+  serialise(query, shapes, positions, next, key.words, symbols);
+
+  key.hash = key.words.size();
+  for (size_t i = 0; i < key.words.size(); i++)
+    key.hash = mix(key.hash, key.words[i]);
+}
+
+QueryCache::EntryList::iterator QueryCache::lookup(const Key& key)
+{
+  typedef std::unordered_multimap<uint64_t, EntryList::iterator>::iterator
+      IndexIterator;
+  std::pair<IndexIterator, IndexIterator> range = index.equal_range(key.hash);
+  for (IndexIterator it = range.first; it != range.second; it++)
+    if (it->second->key == key)
+      return it->second;
+  return entries.end();
+}
+
+const QueryCache::Entry* QueryCache::find(const Key& key)
+{
+  EntryList::iterator it = lookup(key);
+  if (it == entries.end())
+    return NULL;
+
+  // Moving the node leaves the iterators in the index pointing at it.
+  entries.splice(entries.begin(), entries, it);
+  return &*it;
+}
+
+void QueryCache::insert(const Entry& entry)
+{
+  if (capacity == 0)
+    return;
+
+  EntryList::iterator it = lookup(entry.key);
+  if (it != entries.end())
+  {
+    *it = entry;
+    entries.splice(entries.begin(), entries, it);
+    return;
+  }
+
+  while (entries.size() >= capacity)
+  {
+    EntryList::iterator last = --entries.end();
+    typedef std::unordered_multimap<uint64_t, EntryList::iterator>::iterator
+        IndexIterator;
+    std::pair<IndexIterator, IndexIterator> range =
+        index.equal_range(last->key.hash);
+    for (IndexIterator i = range.first; i != range.second; i++)
+      if (i->second == last)
+      {
+        index.erase(i);
+        break;
+      }
+    entries.erase(last);
+  }
+
+  entries.push_front(entry);
+  index.insert(std::make_pair(entry.key.hash, entries.begin()));
+}
+
+void QueryCache::clear()
+{
+  index.clear();
+  entries.clear();
+}
+
+// The caches are made to match the flags, which may have changed since
+// the last query.
+void STP::updateQueryCaches()
+{
+  const size_t capacity = bm->UserFlags.query_cache_size > 0
+                              ? bm->UserFlags.query_cache_size
+                              : 0;
+  if (queryCache != NULL && queryCache->getCapacity() != capacity)
+  {
+    delete queryCache;
+    queryCache = NULL;
+  }
+  if (queryCache == NULL && capacity > 0)
+    queryCache = new QueryCache(capacity);
+
+  const std::string& path = bm->UserFlags.query_cache_file;
+  if (queryCacheFile != NULL && queryCacheFile->getPath() != path)
+  {
+    delete queryCacheFile;
+    queryCacheFile = NULL;
+  }
+  if (queryCacheFile == NULL && !path.empty())
+    queryCacheFile = new QueryCacheFile(path);
+}
+
+// The model is put back as if the solver had just found it, so it is
+// checked and printed the same way.
+bool STP::lookupQueryCache(const QueryCache::Key& key, const ASTVec& symbols,
+                           const ASTNode& original_input,
+                           SOLVER_RETURN_TYPE& result)
+{
+  updateQueryCaches();
+
+  const QueryCache::Entry* entry = NULL;
+  if (queryCache != NULL)
+    entry = queryCache->find(key);
+
+  // Another process may have answered it.
+  QueryCache::Entry from_file;
+  if (entry == NULL && queryCacheFile != NULL &&
+      queryCacheFile->find(key, from_file))
+  {
+    entry = &from_file;
+    if (queryCache != NULL)
+      queryCache->insert(from_file);
+  }
+
+  if (entry == NULL)
+    return false;
+
+  bool want_model = bm->UserFlags.check_counterexample_flag ||
+                    bm->UserFlags.print_counterexample_flag;
+#ifndef NDEBUG
+  want_model = true;
+#endif
+
+  if (entry->result == SOLVER_INVALID && want_model && !entry->has_model)
+    return false;
+
+  bm->UserFlags.construct_counterexample_flag = want_model;
+  Ctr_Example->ClearCounterExampleMap();
+  Ctr_Example->ClearComputeFormulaMap();
+
+  if (entry->result == SOLVER_INVALID && entry->has_model)
+  {
+    assert(entry->model.size() == symbols.size());
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+      const ASTNode& s = symbols[i];
+      const std::vector<unsigned>& chunks = entry->model[i];
+      if (s.GetType() == BOOLEAN_TYPE)
+      {
+        Ctr_Example->SetCounterExample(s, chunks[0] != 0 ? bm->ASTTrue
+                                                         : bm->ASTFalse);
+        continue;
+      }
+
+      const unsigned width = s.GetValueWidth();
+      CBV cbv = CONSTANTBV::BitVector_Create(width, true);
+      for (unsigned j = 0; j < chunks.size(); j++)
+        CONSTANTBV::BitVector_Chunk_Store(
+            cbv, std::min(32u, width - 32 * j), 32 * j, chunks[j]);
+      Ctr_Example->SetCounterExample(s, bm->CreateBVConst(cbv, width));
+    }
+
+    if (bm->UserFlags.check_counterexample_flag &&
+        Ctr_Example->ComputeFormulaUsingModel(original_input) != bm->ASTTrue)
+      FatalError("QueryCache: the cached model doesn't satisfy the input");
+
+    if (bm->UserFlags.print_counterexample_flag)
+    {
+      Ctr_Example->PrintCounterExample(true);
+      Ctr_Example->PrintCounterExample_InOrder(true);
+    }
+  }
+
+  if (entry == &from_file)
+    bm->GetRunTimes()->addCount(RunTimes::QueryCacheFileHit);
+  result = entry->result;
+  return true;
+}
+
+void STP::storeInQueryCache(const QueryCache::Key& key, const ASTVec& symbols,
+                            SOLVER_RETURN_TYPE result)
+{
+  QueryCache::Entry entry;
+  entry.key = key;
+  entry.result = result;
+  entry.has_model = false;
+
+  if (result == SOLVER_INVALID &&
+      bm->UserFlags.construct_counterexample_flag)
+  {
+    // GetCounterExample returns nothing if this is left over from a
+    // valid query.
+    bm->ValidFlag = false;
+
+    entry.has_model = true;
+    entry.model.resize(symbols.size());
+    for (size_t i = 0; i < symbols.size() && entry.has_model; i++)
+    {
+      const ASTNode value = Ctr_Example->GetCounterExample(symbols[i]);
+      if (value == bm->ASTTrue || value == bm->ASTFalse)
+        entry.model[i].push_back(value == bm->ASTTrue ? 1 : 0);
+      else if (value.GetKind() == BVCONST)
+        constantChunks(value, entry.model[i]);
+      else
+        entry.has_model = false;
+    }
+    if (!entry.has_model)
+      entry.model.clear();
+  }
+
+  if (queryCache != NULL)
+    queryCache->insert(entry);
+  if (queryCacheFile != NULL)
+    queryCacheFile->append(entry);
+}
+}
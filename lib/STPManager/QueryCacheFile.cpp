@@ -0,0 +1,389 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/QueryCacheFile.h"
+#include "stp/AST/AST.h"
+#include <cerrno>
+#include <cstring>
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stp
+{
+
+#if !defined(_MSC_VER)
+
+namespace
+{
+
+// The file starts with this and a FileHeader, then holds the records one
+// after another.
+const char file_magic[16] = {'S', 'T', 'P', 'Q', 'u', 'e', 'r', 'y',
+                             'C', 'a', 'c', 'h', 'e', ' ', 'v', '2'};
+
+// How much of file_magic is the same for every version.
+const size_t file_name_size = 13;
+
+// Keys are made of kind numbers, so a file written by a build whose kinds
+// are numbered differently is of no use, and is started again.
+struct FileHeader
+{
+  char magic[16];
+  uint64_t kinds;
+};
+
+uint64_t kindTableHash()
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int k = 0; k < KIND_COUNT; k++)
+  {
+    // The terminating zero keeps the names apart.
+    for (const char* c = _kind_names[k];; c++)
+    {
+      h ^= (unsigned char)*c;
+      h *= 0x100000001b3ULL;
+      if (*c == 0)
+        break;
+    }
+  }
+  return h;
+}
+
+void makeHeader(FileHeader& header)
+{
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, file_magic, sizeof(file_magic));
+  static const uint64_t kinds = kindTableHash();
+  header.kinds = kinds;
+}
+
+const uint32_t record_magic = 0x51435245;
+
+// Followed by "words" 64 bit words: the number of key words, the key
+// words, the result, whether there's a model, the number of symbols in
+// the model, then for each symbol the number of chunks followed by the
+// chunks packed two to a word.
+struct RecordHeader
+{
+  uint32_t magic;
+  uint32_t words;
+  uint64_t hash;
+  uint64_t checksum;
+};
+
+uint64_t checksum(uint64_t hash, const uint64_t* words, size_t n)
+{
+  uint64_t h = hash ^ 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < n; i++)
+  {
+    h ^= words[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+void encode(const QueryCache::Entry& entry, std::vector<uint64_t>& out)
+{
+  out.push_back(entry.key.words.size());
+  out.insert(out.end(), entry.key.words.begin(), entry.key.words.end());
+  out.push_back(entry.result);
+  out.push_back(entry.has_model ? 1 : 0);
+  out.push_back(entry.model.size());
+  for (size_t i = 0; i < entry.model.size(); i++)
+  {
+    const std::vector<unsigned>& chunks = entry.model[i];
+    out.push_back(chunks.size());
+    for (size_t j = 0; j < chunks.size(); j += 2)
+    {
+      uint64_t w = chunks[j];
+      if (j + 1 < chunks.size())
+        w |= (uint64_t)chunks[j + 1] << 32;
+      out.push_back(w);
+    }
+  }
+}
+
+void writeAll(int fd, const char* data, size_t n, size_t offset)
+{
+  while (n > 0)
+  {
+    ssize_t written = pwrite(fd, data, n, offset);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      FatalError("QueryCacheFile: writing the cache file failed");
+    }
+    data += written;
+    offset += written;
+    n -= written;
+  }
+}
+}
+
+QueryCacheFile::QueryCacheFile(const std::string& p)
+    : path(p), mapped(NULL), mapped_size(0), scanned(0)
+{
+  fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    FatalError(("QueryCacheFile: can't open " + path).c_str());
+}
+
+QueryCacheFile::~QueryCacheFile()
+{
+  if (mapped != NULL)
+    munmap((void*)mapped, mapped_size);
+  close(fd);
+}
+
+// Locks that belong to the open file, where they're available, keep
+// two instances in one process that use the same file apart too.
+void QueryCacheFile::lock(bool exclusive)
+{
+  struct flock fl;
+  memset(&fl, 0, sizeof(fl));
+  fl.l_type = exclusive ? F_WRLCK : F_RDLCK;
+  fl.l_whence = SEEK_SET;
+#ifdef F_OFD_SETLKW
+  const int command = F_OFD_SETLKW;
+#else
+  const int command = F_SETLKW;
+#endif
+  while (fcntl(fd, command, &fl) != 0)
+    if (errno != EINTR)
+      FatalError("QueryCacheFile: can't lock the cache file");
+}
+
+void QueryCacheFile::unlock()
+{
+  struct flock fl;
+  memset(&fl, 0, sizeof(fl));
+  fl.l_type = F_UNLCK;
+  fl.l_whence = SEEK_SET;
+#ifdef F_OFD_SETLK
+  fcntl(fd, F_OFD_SETLK, &fl);
+#else
+  fcntl(fd, F_SETLK, &fl);
+#endif
+}
+
+size_t QueryCacheFile::refresh()
+{
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+    FatalError("QueryCacheFile: can't read the size of the cache file");
+  const size_t size = st.st_size;
+
+  if (size != mapped_size)
+  {
+    if (mapped != NULL)
+      munmap((void*)mapped, mapped_size);
+    mapped = NULL;
+    mapped_size = 0;
+    if (size > 0)
+    {
+      void* m = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (m == MAP_FAILED)
+        FatalError("QueryCacheFile: can't map the cache file");
+      mapped = (const char*)m;
+      mapped_size = size;
+    }
+  }
+
+  FileHeader ours;
+  makeHeader(ours);
+  if (size < sizeof(ours) || memcmp(mapped, &ours, sizeof(ours)) != 0)
+  {
+    // New, of another version, or written by a build with other kinds.
+    // Nothing in it is used, and the next append starts it again.
+    if (size >= file_name_size &&
+        memcmp(mapped, file_magic, file_name_size) != 0)
+      FatalError(("QueryCacheFile: not a query cache: " + path).c_str());
+    index.clear();
+    scanned = 0;
+    return size;
+  }
+
+  // Started again by someone else since it was last looked at.
+  if (scanned == 0 || size < scanned)
+  {
+    index.clear();
+    scanned = sizeof(ours);
+  }
+
+  while (scanned + sizeof(RecordHeader) <= size)
+  {
+    RecordHeader h;
+    memcpy(&h, mapped + scanned, sizeof(h));
+    const size_t end = scanned + sizeof(h) + 8 * (size_t)h.words;
+    if (h.magic != record_magic || end > size)
+      break;
+    const uint64_t* words = (const uint64_t*)(mapped + scanned + sizeof(h));
+    if (checksum(h.hash, words, h.words) != h.checksum)
+      break;
+    index.insert(std::make_pair(h.hash, scanned));
+    scanned = end;
+  }
+  return size;
+}
+
+bool QueryCacheFile::decode(size_t offset, QueryCache::Entry& entry) const
+{
+  RecordHeader h;
+  memcpy(&h, mapped + offset, sizeof(h));
+  const uint64_t* w = (const uint64_t*)(mapped + offset + sizeof(h));
+  const uint64_t* const end = w + h.words;
+
+  if (w == end || *w > (uint64_t)(end - w - 1))
+    return false;
+  const size_t key_words = *w++;
+  entry.key.words.assign(w, w + key_words);
+  entry.key.hash = h.hash;
+  w += key_words;
+
+  if (end - w < 3)
+    return false;
+  entry.result = (SOLVER_RETURN_TYPE)*w++;
+  entry.has_model = *w++ != 0;
+  const size_t symbols = *w++;
+
+  entry.model.clear();
+  for (size_t i = 0; i < symbols; i++)
+  {
+    if (w == end)
+      return false;
+    const size_t chunks = *w++;
+    if ((chunks + 1) / 2 > (size_t)(end - w))
+      return false;
+    entry.model.push_back(std::vector<unsigned>());
+    std::vector<unsigned>& m = entry.model.back();
+    for (size_t j = 0; j < chunks; j++)
+      m.push_back((unsigned)(w[j / 2] >> (32 * (j % 2))));
+    w += (chunks + 1) / 2;
+  }
+  return true;
+}
+
+bool QueryCacheFile::find(const QueryCache::Key& key,
+                          QueryCache::Entry& entry)
+{
+  // Held until the records have been read, as a writer may truncate the
+  // file or start it again under the mapping.
+  lock(false);
+  refresh();
+
+  typedef std::unordered_multimap<uint64_t, size_t>::const_iterator
+      IndexIterator;
+  std::pair<IndexIterator, IndexIterator> range = index.equal_range(key.hash);
+  bool found = false;
+  for (IndexIterator it = range.first; it != range.second && !found; it++)
+    found = decode(it->second, entry) && entry.key == key;
+
+  unlock();
+  return found;
+}
+
+void QueryCacheFile::append(const QueryCache::Entry& entry)
+{
+  lock(true);
+  size_t size = refresh();
+
+  if (scanned == 0)
+  {
+    // New, cut short while the header was being written, or written by
+    // another build.
+    if (ftruncate(fd, 0) != 0)
+      FatalError("QueryCacheFile: can't truncate the cache file");
+    FileHeader header;
+    makeHeader(header);
+    writeAll(fd, (const char*)&header, sizeof(header), 0);
+    size = refresh();
+  }
+  else if (scanned < size)
+  {
+    // Whoever was writing this died part way through.
+    if (ftruncate(fd, scanned) != 0)
+      FatalError("QueryCacheFile: can't truncate the cache file");
+    size = refresh();
+  }
+
+  typedef std::unordered_multimap<uint64_t, size_t>::const_iterator
+      IndexIterator;
+  std::pair<IndexIterator, IndexIterator> range =
+      index.equal_range(entry.key.hash);
+  QueryCache::Entry existing;
+  for (IndexIterator it = range.first; it != range.second; it++)
+    if (decode(it->second, existing) && existing.key == entry.key)
+    {
+      unlock();
+      return;
+    }
+
+  std::vector<uint64_t> words;
+  encode(entry, words);
+
+  RecordHeader h;
+  h.magic = record_magic;
+  h.words = words.size();
+  h.hash = entry.key.hash;
+  h.checksum = checksum(h.hash, words.data(), words.size());
+
+  std::vector<char> record(sizeof(h) + 8 * words.size());
+  memcpy(record.data(), &h, sizeof(h));
+  memcpy(record.data() + sizeof(h), words.data(), 8 * words.size());
+  writeAll(fd, record.data(), record.size(), size);
+
+  refresh();
+  unlock();
+}
+
+#else
+
+QueryCacheFile::QueryCacheFile(const std::string& p)
+    : path(p), fd(-1), mapped(NULL), mapped_size(0), scanned(0)
+{
+  FatalError("QueryCacheFile: not supported on this platform");
+}
+
+QueryCacheFile::~QueryCacheFile()
+{
+}
+
+bool QueryCacheFile::find(const QueryCache::Key&, QueryCache::Entry&)
+{
+  return false;
+}
+
+void QueryCacheFile::append(const QueryCache::Entry&)
+{
+}
+
+#endif
+}
@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include "stp/STPManager/STP.h"
 #include "stp/ToSat/AIG/ToSATAIG.h"
+#include "stp/ToSat/AIG/ToSATAIGIncremental.h"
 #include "stp/Simplifier/constantBitP/ConstantBitPropagation.h"
 #include "stp/Simplifier/constantBitP/NodeToFixedBitsMap.h"
 
@@ -70,6 +71,7 @@ SOLVER_RETURN_TYPE STP::solve_by_sat_solver(
 
   if (bm->UserFlags.timeout_max_conflicts >= 0)
     newS->setMaxConflicts(bm->UserFlags.timeout_max_conflicts);
+  newS->setDeadline(&bm->deadline);
 
   SOLVER_RETURN_TYPE result = TopLevelSTPAux(NewSolver, original_input);
   return result;
@@ -114,6 +116,10 @@ SOLVER_RETURN_TYPE STP::TopLevelSTP(
   // overwrite sometimes.
   bool saved_ack = bm->UserFlags.ackermannisation;
 
+  // Turned off while arrays are transformed, which may be where the
+  // deadline passes.
+  const bool saved_optimize = bm->UserFlags.optimize_flag;
+
   ASTNode original_input;
   if (query != bm->ASTFalse)
   {
@@ -123,14 +129,236 @@ SOLVER_RETURN_TYPE STP::TopLevelSTP(
     original_input = inputasserts;
   }
 
-  SATSolver* newS = get_new_sat_solver();
-  SOLVER_RETURN_TYPE result = solve_by_sat_solver(newS, original_input);
-  delete newS;
+  const bool arrays = containsArrayOps(original_input, bm);
+
+  // In IndependenceSlicing.cpp.
+  if (bm->UserFlags.independence_slicing &&
+      !bm->UserFlags.incremental_solving && !arrays)
+  {
+    SOLVER_RETURN_TYPE sliced;
+    if (solve_by_slices(inputasserts, query, sliced))
+      return sliced;
+  }
+
+  bm->soft_timeout_expired = false;
+
+  // Array models aren't kept, so queries with arrays aren't cached.
+  const bool use_cache = (bm->UserFlags.query_cache_size > 0 ||
+                          !bm->UserFlags.query_cache_file.empty()) &&
+                         !arrays;
+  QueryCache::Key key;
+  ASTVec symbols;
+  SOLVER_RETURN_TYPE result;
+  if (use_cache)
+  {
+    QueryCache::makeKey(original_input, key, symbols);
+    if (lookupQueryCache(key, symbols, original_input, result))
+    {
+      bm->GetRunTimes()->addCount(RunTimes::QueryCacheHit);
+      return result;
+    }
+    bm->GetRunTimes()->addCount(RunTimes::QueryCacheMiss);
+  }
+
+  // In ModelReuse.cpp.
+  const bool reuse_models = bm->UserFlags.model_reuse_size > 0 && !arrays;
+  if (reuse_models && tryRecentModels(original_input))
+  {
+    if (use_cache)
+      storeInQueryCache(key, symbols, SOLVER_INVALID);
+    return SOLVER_INVALID;
+  }
+
+  // In UnsatCoreCache.cpp. Each conjunct is solved as an assumption, so
+  // that the failed ones give a core.
+  const bool use_cores = bm->UserFlags.unsat_core_cache_size > 0 && !arrays;
+  ASTVec conjuncts;
+  if (use_cores)
+  {
+    ASTVec top(1, inputasserts);
+    if (query != bm->ASTFalse)
+      top.push_back(bm->CreateNode(NOT, query));
+    const ASTVec flat = FlattenKind(AND, top);
+    for (size_t i = 0; i < flat.size(); i++)
+      if (flat[i] != bm->ASTTrue)
+        conjuncts.push_back(flat[i]);
+
+    if (coveredByUnsatCore(conjuncts))
+    {
+      bm->GetRunTimes()->addCount(RunTimes::UnsatCoreHit);
+      if (use_cache)
+        storeInQueryCache(key, symbols, SOLVER_VALID);
+      return SOLVER_VALID;
+    }
+    bm->GetRunTimes()->addCount(RunTimes::UnsatCoreMiss);
+  }
+
+  bm->deadline.set(bm->UserFlags.timeout_max_time);
+  const size_t timing_depth = bm->GetRunTimes()->depth();
+
+  try
+  {
+    if (use_cores)
+    {
+      ASTVec failed;
+      result = solve_incrementally(bm->ASTTrue, conjuncts, failed);
+      if (result == SOLVER_VALID && !failed.empty())
+        rememberUnsatCore(failed);
+    }
+    else if (bm->UserFlags.incremental_solving && !arrays)
+    {
+      ASTVec failed;
+      result = solve_incrementally(original_input, ASTVec(), failed);
+    }
+    else if (bm->UserFlags.portfolio_threads > 1 &&
+             !bm->UserFlags.incremental_solving)
+    {
+      result = solve_by_portfolio(original_input);
+    }
+    else
+    {
+      std::auto_ptr<SATSolver> newS(get_new_sat_solver());
+      result = solve_by_sat_solver(newS.get(), original_input);
+    }
+  }
+  catch (const DeadlineExpired&)
+  {
+    // The steps that were interrupted never got to stop their timers.
+    bm->GetRunTimes()->unwind(timing_depth);
+    bm->soft_timeout_expired = true;
+    result = SOLVER_TIMEOUT;
+  }
+  bm->deadline.clear();
+
+  if (use_cache && (result == SOLVER_VALID || result == SOLVER_INVALID))
+    storeInQueryCache(key, symbols, result);
+  if (reuse_models && result == SOLVER_INVALID &&
+      bm->UserFlags.construct_counterexample_flag)
+    rememberModel(original_input);
 
   bm->UserFlags.ackermannisation = saved_ack;
+  bm->UserFlags.optimize_flag = saved_optimize;
+  return result;
+}
+
+SOLVER_RETURN_TYPE STP::TopLevelSTPWithAssumptions(
+  const ASTNode& inputasserts,
+  const ASTVec& assumptions
+) {
+  failedAssumptions.clear();
+  if (assumptions.empty())
+    return TopLevelSTP(inputasserts, bm->ASTFalse);
+
+  ASTVec all(assumptions);
+  all.push_back(inputasserts);
+  const ASTNode conjoined = bm->CreateNode(AND, all);
+
+  // Refinement needs a solver of its own, so arrays are solved from
+  // scratch and every assumption is reported as needed.
+  if (containsArrayOps(conjoined, bm))
+  {
+    SOLVER_RETURN_TYPE result = TopLevelSTP(conjoined, bm->ASTFalse);
+    if (result == SOLVER_VALID)
+      failedAssumptions = assumptions;
+    return result;
+  }
+
+  bm->soft_timeout_expired = false;
+  bm->deadline.set(bm->UserFlags.timeout_max_time);
+  const size_t timing_depth = bm->GetRunTimes()->depth();
+
+  SOLVER_RETURN_TYPE result;
+  try
+  {
+    result = solve_incrementally(inputasserts, assumptions, failedAssumptions);
+  }
+  catch (const DeadlineExpired&)
+  {
+    bm->GetRunTimes()->unwind(timing_depth);
+    bm->soft_timeout_expired = true;
+    failedAssumptions.clear();
+    result = SOLVER_TIMEOUT;
+  }
+  bm->deadline.clear();
+  return result;
+}
+
+// The solver and the bit-blasted AIG are kept from the last query, so
+// only the parts of this query that are new get bit-blasted. The
+// simplifications that rewrite the input using the rest of the input
+// (solving for variables, propagating equalities, removing unconstrained
+// variables) aren't done here. Their results depend on every assertion
+// in the query, so they'd need to be undone on each pop, and they would
+// stop the AIG from being shared between queries.
+SOLVER_RETURN_TYPE STP::solve_incrementally(const ASTNode& input,
+                                             const ASTVec& assumptions,
+                                             ASTVec& failed)
+{
+  if (incrementalSolver == NULL)
+  {
+    incrementalSolver = get_new_sat_solver();
+    incrementalSolver->setDeadline(&bm->deadline);
+    if (bm->UserFlags.stats_flag)
+      incrementalSolver->setVerbosity(1);
+    incrementalToSat = new ToSATAIGIncremental(bm);
+  }
+
+  // -1 means no limit, so a limit from an earlier query gets lifted.
+  incrementalSolver->setMaxConflicts(bm->UserFlags.timeout_max_conflicts);
+
+  ASTNode original_input = input;
+  if (!assumptions.empty())
+  {
+    ASTVec all(assumptions);
+    all.push_back(input);
+    original_input = bm->CreateNode(AND, all);
+  }
+
+  bm->ASTNodeStats("input asserts and query: ", original_input);
+
+  if (bm->UserFlags.check_counterexample_flag ||
+      bm->UserFlags.print_counterexample_flag ||
+      bm->UserFlags.model_reuse_size > 0)
+    bm->UserFlags.construct_counterexample_flag = true;
+  else
+    bm->UserFlags.construct_counterexample_flag = false;
+
+  #ifndef NDEBUG
+      bm->UserFlags.construct_counterexample_flag = true;
+  #endif
+
+  ASTNode inputToSat = input;
+  ASTVec assumed(assumptions);
+  if (bm->UserFlags.optimize_flag)
+  {
+    inputToSat = simp->SimplifyFormula_TopLevel(inputToSat, false);
+    for (size_t i = 0; i < assumed.size(); i++)
+      assumed[i] = simp->SimplifyFormula_TopLevel(assumed[i], false);
+    bm->ASTNodeStats("after simplification: ", inputToSat);
+  }
+
+  incrementalToSat->setAssumptions(assumed);
+  SOLVER_RETURN_TYPE result = Ctr_Example->CallSAT_ResultCheck(
+      *incrementalSolver, inputToSat, original_input, incrementalToSat, false);
+
+  if (result == SOLVER_VALID)
+  {
+    const vector<unsigned>& f = incrementalToSat->failedAssumptions();
+    for (size_t i = 0; i < f.size(); i++)
+      failed.push_back(assumptions[f[i]]);
+  }
   return result;
 }
 
+void STP::ClearIncrementalState()
+{
+  delete incrementalToSat;
+  incrementalToSat = NULL;
+
+  delete incrementalSolver;
+  incrementalSolver = NULL;
+}
+
 ASTNode STP::callSizeReducing(ASTNode inputToSat,
                               BVSolver* bvSolver, PropagateEqualities* pe,
                               const int initial_difficulty_score,
@@ -153,6 +381,7 @@ ASTNode STP::callSizeReducing(ASTNode inputToSat,
     BBNodeManagerAIG bitblast_nodemgr;
     BitBlaster<BBNodeAIG, BBNodeManagerAIG> bb(
         &bitblast_nodemgr, simp, bm->defaultNodeFactory, &(bm->UserFlags));
+    bb.deadline = &bm->deadline;
     ASTNodeMap fromTo;
     ASTNodeMap equivs;
     bb.getConsts(inputToSat, fromTo, equivs);
@@ -309,7 +538,9 @@ STP::TopLevelSTPAux(SATSolver& NewSolver, const ASTNode& original_input)
     assert(!arrayops);
   }
 
-  if (bm->UserFlags.check_counterexample_flag || bm->UserFlags.print_counterexample_flag || (arrayops && !removed))
+  if (bm->UserFlags.check_counterexample_flag ||
+      bm->UserFlags.print_counterexample_flag ||
+      bm->UserFlags.model_reuse_size > 0 || (arrayops && !removed))
     bm->UserFlags.construct_counterexample_flag = true;
   else
     bm->UserFlags.construct_counterexample_flag = false;
@@ -370,6 +601,7 @@ STP::TopLevelSTPAux(SATSolver& NewSolver, const ASTNode& original_input)
 
     if (bm->soft_timeout_expired)
       return SOLVER_TIMEOUT;
+    bm->deadline.checkNow();
 
     if (bm->UserFlags.optimize_flag)
     {
@@ -589,9 +821,20 @@ STP::TopLevelSTPAux(SATSolver& NewSolver, const ASTNode& original_input)
     bm->print_stats();
 
   // If it doesn't contain array operations, use ABC's CNF generation.
-  res = Ctr_Example->CallSAT_ResultCheck(
-      NewSolver, inputToSat, original_input, satBase,
-      maybeRefinement);
+  // The aig converter may have deleted the constant bit stuff by the time
+  // the deadline passes.
+  try
+  {
+    res = Ctr_Example->CallSAT_ResultCheck(
+        NewSolver, inputToSat, original_input, satBase,
+        maybeRefinement);
+  }
+  catch (const DeadlineExpired&)
+  {
+    if (toSATAIG.cbIsDestructed())
+      cleaner.release();
+    throw;
+  }
 
   if (bm->soft_timeout_expired)
   {
@@ -616,8 +859,17 @@ STP::TopLevelSTPAux(SATSolver& NewSolver, const ASTNode& original_input)
   assert(arrayops);
   assert(!bm->UserFlags.ackermannisation); // Refinement must be enabled too.
 
-  res = Ctr_Example->SATBased_ArrayReadRefinement(
-      NewSolver, original_input, satBase);
+  try
+  {
+    res = Ctr_Example->SATBased_ArrayReadRefinement(
+        NewSolver, original_input, satBase);
+  }
+  catch (const DeadlineExpired&)
+  {
+    if (toSATAIG.cbIsDestructed())
+      cleaner.release();
+    throw;
+  }
   if (SOLVER_UNDECIDED != res)
   {
     if (toSATAIG.cbIsDestructed())
@@ -34,40 +34,38 @@ namespace stp
 using std::cout;
 using std::endl;
 
-ASTInterior* STPMgr::LookupOrCreateInterior(ASTInterior* n_ptr)
+ASTInterior* STPMgr::LookupOrCreateInterior(ASTInterior& key)
 {
-  ASTInteriorSet::iterator it = _interior_unique_table.find(n_ptr);
-  if (it == _interior_unique_table.end())
-  {
-    // Make a new ASTInterior node We want (NOT alpha) always to
-    // have alpha.nodenum + 1.
-    if (n_ptr->GetKind() == NOT)
-    {
-      // The internal node can't be a NOT, because then we'd add
-      // 1 to the NOT's node number, meaning we'd hit an even number,
-      // which could duplicate the next newNodeNum().
-      assert(n_ptr->GetChildren()[0].GetKind() != NOT);
-    }
+  ASTInteriorSet::iterator it = _interior_unique_table.find(&key);
+  if (it != _interior_unique_table.end())
+    return *it;
 
-    std::pair<ASTInteriorSet::const_iterator, bool> p =
-        _interior_unique_table.insert(n_ptr);
-    return *(p.first);
+  // Make a new ASTInterior node We want (NOT alpha) always to
+  // have alpha.nodenum + 1.
+  if (key.GetKind() == NOT)
+  {
+    // The internal node can't be a NOT, because then we'd add
+    // 1 to the NOT's node number, meaning we'd hit an even number,
+    // which could duplicate the next newNodeNum().
+    assert(key.GetChildren()[0].GetKind() != NOT);
   }
 
-  // Delete the temporary node, and return the found node.
-  delete n_ptr;
-  return *it;
+  ASTInterior* n_ptr =
+      new (interior_arena.allocate()) ASTInterior(std::move(key));
+  n_ptr->node_index = NewNodeIndex();
+  _interior_unique_table.insert(n_ptr);
+  return n_ptr;
 }
 
 ASTInterior* STPMgr::CreateInteriorNode(Kind /*kind*/,
                                         // children array of this
                                         // node will be modified.
-                                        ASTInterior* n_ptr,
+                                        ASTInterior& n,
                                         const ASTVec& back_children)
 {
 
   // insert back_children at end of front_children
-  ASTVec& front_children = n_ptr->_children;
+  ASTVec& front_children = n._children;
   front_children.reserve(front_children.size() + back_children.size());
 
   front_children.insert(front_children.end(), back_children.begin(),
@@ -85,7 +83,7 @@ ASTInterior* STPMgr::CreateInteriorNode(Kind /*kind*/,
     }
   }
 
-  return LookupOrCreateInterior(n_ptr);
+  return LookupOrCreateInterior(n);
 }
 
 ostream& operator<<(ostream& os, const ASTNodeMap& nmap)
@@ -134,8 +132,10 @@ ASTSymbol* STPMgr::LookupOrCreateSymbol(ASTSymbol& s)
     // _name because it's const).  Can cast the iterator to
     // non-const -- carefully.
     // std::string strname(s_ptr->GetName());
-    ASTSymbol* s_ptr1 = new ASTSymbol(this, strdup(s_ptr->GetName()));
+    ASTSymbol* s_ptr1 =
+        new (symbol_arena.allocate()) ASTSymbol(this, strdup(s_ptr->GetName()));
     s_ptr1->_value_width = s_ptr->_value_width;
+    s_ptr1->node_index = NewNodeIndex();
     std::pair<ASTSymbolSet::const_iterator, bool> p =
         _symbol_unique_table.insert(s_ptr1);
     return *p.first;
@@ -312,6 +312,56 @@ ASTNode STPMgr::CreateBVConst(CBV bv, unsigned width)
   return n;
 }
 
+// The copy is built without simplification, so it has the same shape as
+// the original.
+ASTNode STPMgr::ImportNode(const ASTNode& n, ASTNodeMap& cache)
+{
+  ASTNodeMap::const_iterator it = cache.find(n);
+  if (it != cache.end())
+    return it->second;
+
+  ASTNode result;
+  switch (n.GetKind())
+  {
+    case TRUE:
+      result = ASTTrue;
+      break;
+    case FALSE:
+      result = ASTFalse;
+      break;
+    case UNDEFINED:
+      result = ASTUndefined;
+      break;
+    case SYMBOL:
+      result = hashingNodeFactory->CreateSymbol(
+          n.GetName(), n.GetIndexWidth(), n.GetValueWidth());
+      break;
+    case BVCONST:
+      result = CreateBVConst(CONSTANTBV::BitVector_Clone(n.GetBVConst()),
+                             n.GetValueWidth());
+      break;
+    default:
+    {
+      ASTVec children;
+      children.reserve(n.Degree());
+      for (size_t i = 0; i < n.Degree(); i++)
+        children.push_back(ImportNode(n[i], cache));
+
+      if (n.GetType() == BOOLEAN_TYPE)
+        result = hashingNodeFactory->CreateNode(n.GetKind(), children);
+      else if (n.GetType() == ARRAY_TYPE)
+        result = hashingNodeFactory->CreateArrayTerm(
+            n.GetKind(), n.GetIndexWidth(), n.GetValueWidth(), children);
+      else
+        result = hashingNodeFactory->CreateTerm(n.GetKind(),
+                                                n.GetValueWidth(), children);
+    }
+  }
+
+  cache.insert(std::make_pair(n, result));
+  return result;
+}
+
 ASTNode STPMgr::CreateZeroConst(unsigned width)
 {
   assert(width > 0);
@@ -394,7 +444,8 @@ ASTBVConst* STPMgr::LookupOrCreateBVConst(ASTBVConst& s)
   {
     // Make a new ASTBVConst with duplicated constant.
 
-    ASTBVConst* s_copy = new ASTBVConst(s);
+    ASTBVConst* s_copy = new (bvconst_arena.allocate()) ASTBVConst(s);
+    s_copy->node_index = NewNodeIndex();
 
     std::pair<ASTBVConstSet::const_iterator, bool> p =
         _bvconst_unique_table.insert(s_copy);
@@ -556,13 +607,10 @@ bool STPMgr::VarSeenInTerm(const ASTNode& var, const ASTNode& term)
     return true;
   }
 
-  ASTNodeMap::iterator it;
-  if ((it = TermsAlreadySeenMap.find(term)) != TermsAlreadySeenMap.end())
+  const ASTNode* seen = TermsAlreadySeenMap.find(term);
+  if (seen != NULL && *seen == var)
   {
-    if (it->second == var)
-    {
-      return false;
-    }
+    return false;
   }
 
   if (var == term)
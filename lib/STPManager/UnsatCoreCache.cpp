@@ -0,0 +1,66 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/STPManager/STP.h"
+
+namespace stp
+{
+
+// Cores are compared by node, which is enough for queries that keep
+// adding to the same path condition.
+bool STP::coveredByUnsatCore(const ASTVec& conjuncts)
+{
+  if (unsatCores.empty())
+    return false;
+
+  const ASTNodeSet present(conjuncts.begin(), conjuncts.end());
+  for (std::list<ASTVec>::iterator it = unsatCores.begin();
+       it != unsatCores.end(); it++)
+  {
+    const ASTVec& core = *it;
+    size_t i = 0;
+    while (i < core.size() && present.find(core[i]) != present.end())
+      i++;
+    if (i == core.size())
+    {
+      unsatCores.splice(unsatCores.begin(), unsatCores, it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void STP::rememberUnsatCore(const ASTVec& core)
+{
+  for (std::list<ASTVec>::iterator it = unsatCores.begin();
+       it != unsatCores.end(); it++)
+    if (*it == core)
+      return;
+
+  unsatCores.push_front(core);
+  while (unsatCores.size() > (size_t)bm->UserFlags.unsat_core_cache_size)
+    unsatCores.pop_back();
+}
+}
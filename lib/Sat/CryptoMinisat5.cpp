@@ -25,6 +25,8 @@ THE SOFTWARE.
 #include "stp/Sat/CryptoMinisat5.h"
 #include "cryptominisat5/cryptominisat.h"
 #include <vector>
+#include <limits>
+#include <algorithm>
 using std::vector;
 
 namespace stp
@@ -47,6 +49,7 @@ CryptoMiniSat5::CryptoMiniSat5(int num_threads)
   s->set_default_polarity(false);
   //s->set_allow_otf_gauss();
   temp_cl = (void*)new vector<CMSat::Lit>;
+  conflict_limited = false;
 }
 
 CryptoMiniSat5::~CryptoMiniSat5()
@@ -59,7 +62,15 @@ CryptoMiniSat5::~CryptoMiniSat5()
 void CryptoMiniSat5::setMaxConflicts(int64_t max_confl)
 {
   if (max_confl> 0)
+  {
     s->set_max_confl(max_confl);
+    conflict_limited = true;
+  }
+  else if (max_confl < 0)
+  {
+    s->set_max_confl(std::numeric_limits<int64_t>::max());
+    conflict_limited = false;
+  }
 }
 
 bool
@@ -84,15 +95,76 @@ CryptoMiniSat5::okay() const // FALSE means solver is in a conflicting state
   return s->okay();
 }
 
+// With a deadline the search runs for at most this many seconds at a time,
+// so that a cancelled query stops promptly.
+static const double seconds_per_deadline_check = 0.25;
+
+// Cryptominisat measures CPU time rather than wall-clock time, so with
+// several threads it may give up early. A time slice that runs out can't be
+// told apart from the conflict budget running out, so with a budget the
+// search isn't sliced and can only be cancelled at the end.
+static CMSat::lbool solveLimited(CMSat::SATSolver* s, Deadline* deadline,
+                                 bool conflict_limited,
+                                 vector<CMSat::Lit>* assumptions)
+{
+  if (deadline == NULL || !deadline->isSet())
+  {
+    s->set_max_time(std::numeric_limits<double>::max());
+    return s->solve(assumptions);
+  }
+
+  if (conflict_limited)
+  {
+    s->set_max_time(deadline->remaining() / 1000.0);
+    return s->solve(assumptions);
+  }
+
+  CMSat::lbool ret = CMSat::l_Undef;
+  while (ret == CMSat::l_Undef && !deadline->expired())
+  {
+    s->set_max_time(std::min(deadline->remaining() / 1000.0,
+                             seconds_per_deadline_check));
+    ret = s->solve(assumptions);
+  }
+  return ret;
+}
+
 bool CryptoMiniSat5::solve(bool& timeout_expired) // Search without assumptions.
 {
-  CMSat::lbool ret = s->solve();
+  CMSat::lbool ret = solveLimited(s, deadline, conflict_limited, NULL);
   if (ret == CMSat::l_Undef) {
     timeout_expired = true;
   }
   return ret == CMSat::l_True;
 }
 
+bool CryptoMiniSat5::solveWithAssumptions(const vec_literals& assumptions,
+                                          bool& timeout_expired)
+{
+  vector<CMSat::Lit> assumps;
+  assumps.reserve(assumptions.size());
+  for (int i = 0; i < assumptions.size(); i++)
+  {
+    assumps.push_back(CMSat::Lit(var(assumptions[i]), sign(assumptions[i])));
+  }
+
+  CMSat::lbool ret = solveLimited(s, deadline, conflict_limited, &assumps);
+  if (ret == CMSat::l_Undef) {
+    timeout_expired = true;
+  }
+  return ret == CMSat::l_True;
+}
+
+// Like minisat, the conflict holds the negations of the failed assumptions.
+void CryptoMiniSat5::getFailedAssumptions(vec_literals& failed)
+{
+  const vector<CMSat::Lit>& conflict = s->get_conflict();
+  for (size_t i = 0; i < conflict.size(); i++)
+  {
+    failed.push(SATSolver::mkLit(conflict[i].var(), !conflict[i].sign()));
+  }
+}
+
 uint8_t CryptoMiniSat5::modelValue(uint32_t x) const
 {
   return (s->get_model().at(x) == CMSat::l_True);
@@ -41,9 +41,14 @@ uint8_t MinisatCore::value(uint32_t x) const {
   return Minisat::toInt(s->value(x));
 }
 
+// With a deadline the search runs for this many propagations at a time,
+// with the clock read in between.
+static const int64_t propagations_per_deadline_check = 1 << 20;
+
 MinisatCore::MinisatCore()
 {
   s = new Minisat::Solver;
+  conflict_limit = -1;
 }
 
 MinisatCore::~MinisatCore()
@@ -53,7 +58,41 @@ MinisatCore::~MinisatCore()
 
 void MinisatCore::setMaxConflicts(int64_t max_confl)
 {
-  s->setConfBudget(max_confl);
+  // The solver can be reused between queries, so a negative (unlimited)
+  // budget has to clear whatever budget an earlier query set.
+  if (max_confl < 0)
+  {
+    s->budgetOff();
+    conflict_limit = -1;
+  }
+  else
+  {
+    s->setConfBudget(max_confl);
+    conflict_limit = s->conflicts + max_confl;
+  }
+}
+
+// Each time around the loop minisat begins its restart sequence again, but
+// it keeps what it has learnt.
+Minisat::lbool
+MinisatCore::solveLimited(const stp::SATSolver::vec_literals& assumptions)
+{
+  if (deadline == NULL || !deadline->isSet())
+  {
+    s->setPropBudget(~0ULL >> 2); // Undo any earlier deadline.
+    return s->solveLimited(assumptions);
+  }
+
+  while (!deadline->expired())
+  {
+    s->setPropBudget(propagations_per_deadline_check);
+    Minisat::lbool ret = s->solveLimited(assumptions);
+    if (ret != (Minisat::lbool)l_Undef)
+      return ret;
+    if (conflict_limit >= 0 && s->conflicts >= (uint64_t)conflict_limit)
+      break;
+  }
+  return (Minisat::lbool)l_Undef;
 }
 
 
@@ -86,8 +125,22 @@ bool MinisatCore::solve(bool& timeout_expired) // Search without assumptions.
   if (!s->simplify())
     return false;
 
-  Minisat::vec<Minisat::Lit> assumps;
-  Minisat::lbool ret = s->solveLimited(assumps);
+  stp::SATSolver::vec_literals assumps;
+  Minisat::lbool ret = solveLimited(assumps);
+  if (ret == (Minisat::lbool)l_Undef) {
+    timeout_expired = true;
+  }
+
+  return ret == (Minisat::lbool)l_True;
+}
+
+bool MinisatCore::solveWithAssumptions(
+    const stp::SATSolver::vec_literals& assumptions, bool& timeout_expired)
+{
+  if (!s->simplify())
+    return false;
+
+  Minisat::lbool ret = solveLimited(assumptions);
   if (ret == (Minisat::lbool)l_Undef) {
     timeout_expired = true;
   }
@@ -95,6 +148,13 @@ bool MinisatCore::solve(bool& timeout_expired) // Search without assumptions.
   return ret == (Minisat::lbool)l_True;
 }
 
+// Minisat's conflict holds the negations of the failed assumptions.
+void MinisatCore::getFailedAssumptions(stp::SATSolver::vec_literals& failed)
+{
+  for (int i = 0; i < s->conflict.size(); i++)
+    failed.push(~s->conflict[i]);
+}
+
 uint8_t MinisatCore::modelValue(uint32_t x) const
 {
   return Minisat::toInt(s->modelValue(x));
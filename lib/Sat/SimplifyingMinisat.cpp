@@ -35,9 +35,14 @@ namespace stp
 {
 using std::cout;
 
+// With a deadline the search runs for this many propagations at a time,
+// with the clock read in between.
+static const int64_t propagations_per_deadline_check = 1 << 20;
+
 SimplifyingMinisat::SimplifyingMinisat()
 {
   s = new Minisat::SimpSolver();
+  conflict_limit = -1;
 }
 
 SimplifyingMinisat::~SimplifyingMinisat()
@@ -48,7 +53,40 @@ SimplifyingMinisat::~SimplifyingMinisat()
 void SimplifyingMinisat::setMaxConflicts(int64_t max_confl)
 {
   if (max_confl> 0)
+  {
     s->setConfBudget(max_confl);
+    conflict_limit = s->conflicts + max_confl;
+  }
+  else if (max_confl < 0)
+  {
+    s->budgetOff();
+    conflict_limit = -1;
+  }
+}
+
+// Each time around the loop minisat begins its restart sequence again, but
+// it keeps what it has learnt. Variables are only eliminated the first time.
+Minisat::lbool
+SimplifyingMinisat::solveLimited(const vec_literals& assumptions)
+{
+  if (deadline == NULL || !deadline->isSet())
+  {
+    s->setPropBudget(~0ULL >> 2); // Undo any earlier deadline.
+    return s->solveLimited(assumptions);
+  }
+
+  bool do_simp = true;
+  while (!deadline->expired())
+  {
+    s->setPropBudget(propagations_per_deadline_check);
+    Minisat::lbool ret = s->solveLimited(assumptions, do_simp);
+    if (ret != (Minisat::lbool)l_Undef)
+      return ret;
+    if (conflict_limit >= 0 && s->conflicts >= (uint64_t)conflict_limit)
+      break;
+    do_simp = false;
+  }
+  return (Minisat::lbool)l_Undef;
 }
 
 bool SimplifyingMinisat::addClause(
@@ -68,8 +106,8 @@ bool SimplifyingMinisat::solve(bool& timeout_expired) // Search without assumpti
   if (!s->simplify())
     return false;
 
-  Minisat::vec<Minisat::Lit> assumps;
-  Minisat::lbool ret = s->solveLimited(assumps);
+  vec_literals assumps;
+  Minisat::lbool ret = solveLimited(assumps);
   if (ret == (Minisat::lbool)l_Undef) {
     timeout_expired = true;
   }
@@ -77,6 +115,28 @@ bool SimplifyingMinisat::solve(bool& timeout_expired) // Search without assumpti
   return s->okay();
 }
 
+// The caller must have frozen every variable that it may later mention in
+// an assumption or a new clause, otherwise it may have been eliminated.
+bool SimplifyingMinisat::solveWithAssumptions(
+    const vec_literals& assumptions, bool& timeout_expired)
+{
+  if (!s->simplify())
+    return false;
+
+  Minisat::lbool ret = solveLimited(assumptions);
+  if (ret == (Minisat::lbool)l_Undef) {
+    timeout_expired = true;
+  }
+
+  return ret == (Minisat::lbool)l_True;
+}
+
+void SimplifyingMinisat::getFailedAssumptions(vec_literals& failed)
+{
+  for (int i = 0; i < s->conflict.size(); i++)
+    failed.push(~s->conflict[i]);
+}
+
 bool SimplifyingMinisat::simplify() // Removes already satisfied clauses.
 {
   return s->simplify();
@@ -93,23 +93,22 @@ bool Simplifier::CheckSimplifyMap(const ASTNode& key, ASTNode& output,
     return true;
   }
 
-  ASTNodeMap::iterator it, itend;
-  it = pushNeg ? SimplifyNegMap->find(key) : SimplifyMap->find(key);
-  itend = pushNeg ? SimplifyNegMap->end() : SimplifyMap->end();
+  const ASTNode* found =
+      pushNeg ? SimplifyNegMap->find(key) : SimplifyMap->find(key);
 
-  if (it != itend)
+  if (found != NULL)
   {
-    output = it->second;
+    output = *found;
     CountersAndStats("Successful_CheckSimplifyMap", _bm);
     return true;
   }
 
-  if (pushNeg && (it = SimplifyMap->find(key)) != SimplifyMap->end())
+  if (pushNeg && (found = SimplifyMap->find(key)) != NULL)
   {
-    output = (ASTFalse == it->second)
+    output = (ASTFalse == *found)
                  ? ASTTrue
-                 : (ASTTrue == it->second) ? ASTFalse
-                                           : nf->CreateNode(NOT, it->second);
+                 : (ASTTrue == *found) ? ASTFalse
+                                       : nf->CreateNode(NOT, *found);
     CountersAndStats("2nd_Successful_CheckSimplifyMap", _bm);
     return true;
   }
@@ -259,7 +258,7 @@ void Simplifier::checkIfInSimplifyMap(const ASTNode& n, ASTNodeSet visited)
   if (visited.find(n) != visited.end())
     return;
 
-  if (SimplifyMap->find(n) == SimplifyMap->end())
+  if (!SimplifyMap->contains(n))
   {
     cerr << "not found";
     cerr << n;
@@ -322,6 +321,8 @@ ASTNode Simplifier::SimplifyFormula(const ASTNode& b, bool pushNeg,
   if (CheckSimplifyMap(b, output, pushNeg, VarConstMap))
     return output;
 
+  _bm->deadline.check();
+
   Kind kind = b.GetKind();
 
   ASTNode a = b;
@@ -1652,12 +1653,12 @@ bool Simplifier::hasBeenSimplified(const ASTNode& n)
   if (n.GetKind() == SYMBOL)
     return true;
 
-  ASTNodeMap::const_iterator it;
   // If it's in the simplification map, it has been simplified.
-  if ((it = SimplifyMap->find(n)) == SimplifyMap->end())
+  const ASTNode* found = SimplifyMap->find(n);
+  if (found == NULL)
     return false;
 
-  return (it->second == n);
+  return (*found == n);
 }
 
 // If both of the children are sign extended. Makes this node sign extended too.
@@ -1847,6 +1848,8 @@ ASTNode Simplifier::SimplifyTerm(const ASTNode& actualInputterm,
     // output << endl;
     return output;
   }
+
+  _bm->deadline.check();
   //########################################
   //########################################
 
@@ -3719,19 +3722,19 @@ void Simplifier::ResetSimplifyMaps()
 
   // SimplifyMap->clear();
   delete SimplifyMap;
-  SimplifyMap = new ASTNodeMap(INITIAL_TABLE_SIZE);
+  SimplifyMap = new NodeVector<ASTNode>();
 
   // SimplifyNegMap->clear();
   delete SimplifyNegMap;
-  SimplifyNegMap = new ASTNodeMap(INITIAL_TABLE_SIZE);
+  SimplifyNegMap = new NodeVector<ASTNode>();
 }
 
 void Simplifier::printCacheStatus()
 {
   cerr << "SimplifyMap:" << SimplifyMap->size() << ":"
-       << SimplifyMap->bucket_count() << endl;
+       << SimplifyMap->capacity() << endl;
   cerr << "SimplifyNegMap:" << SimplifyNegMap->size() << ":"
-       << SimplifyNegMap->bucket_count() << endl;
+       << SimplifyNegMap->capacity() << endl;
   cerr << "AlwaysTrueFormSet" << AlwaysTrueHashSet.size() << ":"
        << AlwaysTrueHashSet.bucket_count() << endl;
   cerr << "MultInverseMap" << MultInverseMap.size() << ":"
@@ -0,0 +1,226 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include <cassert>
+#include <random>
+
+#include "stp/ToSat/AIG/AIGSimulator.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define STP_AIG_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace stp
+{
+
+namespace
+{
+typedef AIGSimulator::Gate Gate;
+
+inline void simulateWord(const Gate& g, uint64_t* s, int w)
+{
+  const uint64_t a = s[g.in0 + w] ^ g.mask0;
+  const uint64_t b = s[g.in1 + w] ^ g.mask1;
+  s[g.out + w] = g.exor ? (a ^ b) : (a & b);
+}
+
+void simulateScalar(const std::vector<Gate>& gates, uint64_t* s, int words)
+{
+  for (size_t i = 0; i < gates.size(); i++)
+    for (int w = 0; w < words; w++)
+      simulateWord(gates[i], s, w);
+}
+
+#ifdef STP_AIG_SIMD
+// Compiled for the instruction sets by attribute, so the rest of the
+// library doesn't need them, and only called once the CPU is known to
+// have them.
+__attribute__((target("avx2"))) void
+simulateAVX2(const std::vector<Gate>& gates, uint64_t* s, int words)
+{
+  for (size_t i = 0; i < gates.size(); i++)
+  {
+    const Gate& g = gates[i];
+    const __m256i m0 = _mm256_set1_epi64x((long long)g.mask0);
+    const __m256i m1 = _mm256_set1_epi64x((long long)g.mask1);
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+    {
+      const __m256i a = _mm256_xor_si256(
+          _mm256_loadu_si256((const __m256i*)(s + g.in0 + w)), m0);
+      const __m256i b = _mm256_xor_si256(
+          _mm256_loadu_si256((const __m256i*)(s + g.in1 + w)), m1);
+      _mm256_storeu_si256((__m256i*)(s + g.out + w),
+                          g.exor ? _mm256_xor_si256(a, b)
+                                 : _mm256_and_si256(a, b));
+    }
+    for (; w < words; w++)
+      simulateWord(g, s, w);
+  }
+}
+
+__attribute__((target("avx512f,avx2"))) void
+simulateAVX512(const std::vector<Gate>& gates, uint64_t* s, int words)
+{
+  for (size_t i = 0; i < gates.size(); i++)
+  {
+    const Gate& g = gates[i];
+    const __m512i m0 = _mm512_set1_epi64((long long)g.mask0);
+    const __m512i m1 = _mm512_set1_epi64((long long)g.mask1);
+    int w = 0;
+    for (; w + 8 <= words; w += 8)
+    {
+      const __m512i a =
+          _mm512_xor_si512(_mm512_loadu_si512(s + g.in0 + w), m0);
+      const __m512i b =
+          _mm512_xor_si512(_mm512_loadu_si512(s + g.in1 + w), m1);
+      _mm512_storeu_si512(s + g.out + w, g.exor ? _mm512_xor_si512(a, b)
+                                                : _mm512_and_si512(a, b));
+    }
+    // So 256 patterns aren't left to the scalar loop.
+    if (w + 4 <= words)
+    {
+      const __m256i a =
+          _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(s + g.in0 + w)),
+                           _mm512_castsi512_si256(m0));
+      const __m256i b =
+          _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(s + g.in1 + w)),
+                           _mm512_castsi512_si256(m1));
+      _mm256_storeu_si256((__m256i*)(s + g.out + w),
+                          g.exor ? _mm256_xor_si256(a, b)
+                                 : _mm256_and_si256(a, b));
+      w += 4;
+    }
+    for (; w < words; w++)
+      simulateWord(g, s, w);
+  }
+}
+#endif
+}
+
+AIGSimulator::AIGSimulator(Aig_Man_t* _p, int words)
+    : p(_p), nWords(words), kernel(SCALAR),
+      sims((size_t)Aig_ManObjNumMax(_p) * words, 0)
+{
+  assert(words > 0);
+  if (supported(AVX512))
+    kernel = AVX512;
+  else if (supported(AVX2))
+    kernel = AVX2;
+
+  uint64_t* one = &sims[(size_t)Aig_ManConst1(p)->Id * nWords];
+  for (int w = 0; w < nWords; w++)
+    one[w] = ~(uint64_t)0;
+
+  Vec_Ptr_t* nodes = Aig_ManDfs(p);
+  gates.reserve(Vec_PtrSize(nodes));
+  for (int i = 0; i < Vec_PtrSize(nodes); i++)
+  {
+    Aig_Obj_t* o = (Aig_Obj_t*)Vec_PtrEntry(nodes, i);
+    if (!Aig_ObjIsNode(o))
+      continue;
+
+    Gate g;
+    g.out = (size_t)o->Id * nWords;
+    g.in0 = (size_t)Aig_ObjFanin0(o)->Id * nWords;
+    g.in1 = (size_t)Aig_ObjFanin1(o)->Id * nWords;
+    g.mask0 = Aig_ObjFaninC0(o) ? ~(uint64_t)0 : 0;
+    g.mask1 = Aig_ObjFaninC1(o) ? ~(uint64_t)0 : 0;
+    g.exor = Aig_ObjIsExor(o);
+    gates.push_back(g);
+  }
+  Vec_PtrFree(nodes);
+}
+
+bool AIGSimulator::supported(Kernel k)
+{
+#ifdef STP_AIG_SIMD
+  __builtin_cpu_init();
+#endif
+  switch (k)
+  {
+    case SCALAR:
+      return true;
+#ifdef STP_AIG_SIMD
+    case AVX2:
+      return __builtin_cpu_supports("avx2");
+    case AVX512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+const char* AIGSimulator::name(Kernel k)
+{
+  switch (k)
+  {
+    case AVX2:
+      return "avx2";
+    case AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+void AIGSimulator::setKernel(Kernel k)
+{
+  assert(supported(k));
+  kernel = k;
+}
+
+void AIGSimulator::randomize(uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  for (int i = 0; i < Aig_ManPiNum(p); i++)
+  {
+    uint64_t* v = pi(i);
+    for (int w = 0; w < nWords; w++)
+      v[w] = rng();
+  }
+}
+
+void AIGSimulator::simulate()
+{
+  switch (kernel)
+  {
+#ifdef STP_AIG_SIMD
+    case AVX512:
+      simulateAVX512(gates, &sims[0], nWords);
+      break;
+    case AVX2:
+      simulateAVX2(gates, &sims[0], nWords);
+      break;
+#endif
+    default:
+      simulateScalar(gates, &sims[0], nWords);
+      break;
+  }
+}
+}
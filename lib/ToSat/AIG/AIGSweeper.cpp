@@ -0,0 +1,338 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "stp/Sat/MinisatCore.h"
+#include "stp/ToSat/AIG/AIGSimulator.h"
+#include "stp/ToSat/AIG/AIGSweeper.h"
+
+namespace stp
+{
+
+namespace
+{
+// Each node is simulated on this many words of random patterns, and on
+// one more word of the counterexamples the SAT solver has found.
+const int RANDOM_WORDS = 4;
+
+// Nodes are checked against at most this many of the nodes they can't be
+// told apart from.
+const int MAX_CANDIDATES = 4;
+
+enum Result
+{
+  PROVED,
+  DISPROVED,
+  UNDECIDED
+};
+
+class Sweep
+{
+  Aig_Man_t* p;
+  const int conflicts;
+  std::mt19937_64 rng;
+  MinisatCore solver;
+
+  AIGSimulator random;
+  // By Id, the counterexample word.
+  std::vector<uint64_t> cex;
+  // By Id, -1 until the object is encoded.
+  std::vector<int> satVar;
+  // By Id, the (maybe complemented) node an object was merged into.
+  std::vector<Aig_Obj_t*> repr;
+  int cexes;
+
+  // What to use in place of child, which may be complemented.
+  Aig_Obj_t* canonical(Aig_Obj_t* child)
+  {
+    Aig_Obj_t* r = repr[Aig_Regular(child)->Id];
+    return (r == NULL) ? child : Aig_NotCond(r, Aig_IsComplement(child));
+  }
+
+  // Merged nodes have their representative's variable, so the solver
+  // only ever sees the swept AIG. Iterative, because AIGs from adder
+  // chains are very deep.
+  void encode(Aig_Obj_t* root)
+  {
+    std::vector<Aig_Obj_t*> stack(1, root);
+    while (!stack.empty())
+    {
+      Aig_Obj_t* o = stack.back();
+      if (satVar[o->Id] >= 0)
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      if (Aig_ObjIsConst1(o))
+      {
+        satVar[o->Id] = solver.newVar();
+        SATSolver::vec_literals unit;
+        unit.push(SATSolver::mkLit(satVar[o->Id], false));
+        solver.addClause(unit);
+      }
+      else if (Aig_ObjIsPi(o))
+        satVar[o->Id] = solver.newVar();
+      else
+      {
+        Aig_Obj_t* f0 = Aig_Regular(canonical(Aig_ObjChild0(o)));
+        Aig_Obj_t* f1 = Aig_Regular(canonical(Aig_ObjChild1(o)));
+        if (satVar[f0->Id] < 0 || satVar[f1->Id] < 0)
+        {
+          if (satVar[f0->Id] < 0)
+            stack.push_back(f0);
+          if (satVar[f1->Id] < 0)
+            stack.push_back(f1);
+          continue;
+        }
+
+        satVar[o->Id] = solver.newVar();
+        const Minisat::Lit z = SATSolver::mkLit(satVar[o->Id], false);
+        const Minisat::Lit a = lit(canonical(Aig_ObjChild0(o)));
+        const Minisat::Lit b = lit(canonical(Aig_ObjChild1(o)));
+
+        SATSolver::vec_literals c;
+        c.push(~z);
+        c.push(a);
+        solver.addClause(c);
+        c.clear();
+        c.push(~z);
+        c.push(b);
+        solver.addClause(c);
+        c.clear();
+        c.push(z);
+        c.push(~a);
+        c.push(~b);
+        solver.addClause(c);
+      }
+      stack.pop_back();
+    }
+  }
+
+  Minisat::Lit lit(Aig_Obj_t* child)
+  {
+    encode(Aig_Regular(child));
+    return SATSolver::mkLit(satVar[Aig_Regular(child)->Id],
+                            Aig_IsComplement(child));
+  }
+
+  // Puts the solver's model into the counterexample word, and resimulates
+  // that word for nodes[0..upto].
+  void addCounterexample(const std::vector<Aig_Obj_t*>& nodes, int upto)
+  {
+    const int bit = cexes++ % 64;
+    const uint64_t mask = (uint64_t)1 << bit;
+
+    for (int i = 0; i < Aig_ManPiNum(p); i++)
+    {
+      Aig_Obj_t* pObj = Aig_ManPi(p, i);
+      bool value;
+      if (satVar[pObj->Id] >= 0)
+        value = solver.modelValue(satVar[pObj->Id]) == solver.true_literal();
+      else
+        value = rng() & 1;
+
+      uint64_t& w = cex[pObj->Id];
+      w = value ? (w | mask) : (w & ~mask);
+    }
+
+    for (int i = 0; i <= upto; i++)
+      simulate(nodes[i]);
+  }
+
+public:
+  int proved, disproved, undecided;
+
+  Sweep(Aig_Man_t* _p, int _conflicts)
+      : p(_p), conflicts(_conflicts), rng(0x5eed),
+        random(_p, RANDOM_WORDS), cex(Aig_ManObjNumMax(_p), 0),
+        satVar(Aig_ManObjNumMax(_p), -1), repr(Aig_ManObjNumMax(_p), NULL),
+        cexes(0), proved(0), disproved(0), undecided(0)
+  {
+    random.randomize(rng());
+    random.simulate();
+    cex[Aig_ManConst1(p)->Id] = ~(uint64_t)0;
+  }
+
+  Aig_Obj_t* representative(Aig_Obj_t* o) { return repr[o->Id]; }
+
+  // Whether o is the same as a, after complementing a if phase is set,
+  // going by the patterns simulated so far.
+  bool sameSims(Aig_Obj_t* o, Aig_Obj_t* a, bool phase)
+  {
+    const uint64_t c = phase ? ~(uint64_t)0 : 0;
+    if (cex[o->Id] != (cex[a->Id] ^ c))
+      return false;
+    for (int i = 0; i < RANDOM_WORDS; i++)
+      if (random.values(o)[i] != (random.values(a)[i] ^ c))
+        return false;
+    return true;
+  }
+
+  // The random patterns, complemented if needed so the first is 0. Equal
+  // or complementary nodes have the same key.
+  uint64_t key(Aig_Obj_t* o)
+  {
+    const uint64_t* v = random.values(o);
+    const uint64_t c = (v[0] & 1) ? ~(uint64_t)0 : 0;
+    uint64_t h = 0;
+    for (int i = 0; i < RANDOM_WORDS; i++)
+      h = (h ^ (v[i] ^ c)) * 0x9E3779B97F4A7C15ULL;
+    return h;
+  }
+
+  bool phase(Aig_Obj_t* o, Aig_Obj_t* a)
+  {
+    return ((random.values(o)[0] ^ random.values(a)[0]) & 1) != 0;
+  }
+
+  // The random words are simulated up front, so only the counterexample
+  // word is left.
+  void simulate(Aig_Obj_t* o)
+  {
+    const uint64_t ca = Aig_ObjFaninC0(o) ? ~(uint64_t)0 : 0;
+    const uint64_t cb = Aig_ObjFaninC1(o) ? ~(uint64_t)0 : 0;
+    cex[o->Id] = (cex[Aig_ObjFanin0(o)->Id] ^ ca) &
+                 (cex[Aig_ObjFanin1(o)->Id] ^ cb);
+  }
+
+  // Checks whether node o, the upto'th of nodes, is equal to a,
+  // complemented if phase is set.
+  Result prove(Aig_Obj_t* o, Aig_Obj_t* a, bool phase,
+               const std::vector<Aig_Obj_t*>& nodes, int upto)
+  {
+    const Minisat::Lit lo = lit(o);
+    const Minisat::Lit la = lit(Aig_NotCond(a, phase));
+
+    for (int polarity = 0; polarity < 2; polarity++)
+    {
+      SATSolver::vec_literals assumptions;
+      assumptions.push(polarity ? ~lo : lo);
+      assumptions.push(polarity ? la : ~la);
+
+      solver.setMaxConflicts(conflicts);
+      bool timeout = false;
+      if (solver.solveWithAssumptions(assumptions, timeout))
+      {
+        addCounterexample(nodes, upto);
+        disproved++;
+        return DISPROVED;
+      }
+      if (timeout)
+      {
+        undecided++;
+        return UNDECIDED;
+      }
+    }
+
+    repr[o->Id] = Aig_NotCond(a, phase);
+    proved++;
+    return PROVED;
+  }
+};
+}
+
+Aig_Man_t* AIGSweeper::sweep(Aig_Man_t* p)
+{
+  const long start = Deadline::now();
+  const long end = start + uf.aig_sweep_ms;
+
+  Sweep s(p, uf.aig_sweep_conflicts);
+
+  std::vector<Aig_Obj_t*> nodes;
+  Vec_Ptr_t* dfs = Aig_ManDfs(p);
+  for (int i = 0; i < Vec_PtrSize(dfs); i++)
+    nodes.push_back((Aig_Obj_t*)Vec_PtrEntry(dfs, i));
+  Vec_PtrFree(dfs);
+
+  // The nodes that haven't been merged, by key.
+  std::unordered_map<uint64_t, std::vector<Aig_Obj_t*> > classes;
+  classes[s.key(Aig_ManConst1(p))].push_back(Aig_ManConst1(p));
+  for (int i = 0; i < Aig_ManPiNum(p); i++)
+    classes[s.key(Aig_ManPi(p, i))].push_back(Aig_ManPi(p, i));
+
+  bool stopped = false;
+  for (int i = 0; i < (int)nodes.size(); i++)
+  {
+    Aig_Obj_t* pObj = nodes[i];
+    s.simulate(pObj);
+    if (stopped)
+      continue;
+
+    std::vector<Aig_Obj_t*>& c = classes[s.key(pObj)];
+    int tried = 0;
+    for (size_t j = 0; j < c.size() && tried < MAX_CANDIDATES; j++)
+    {
+      const bool phase = s.phase(pObj, c[j]);
+      if (!s.sameSims(pObj, c[j], phase))
+        continue;
+
+      tried++;
+      if (s.prove(pObj, c[j], phase, nodes, i) == PROVED)
+        break;
+    }
+    if (s.representative(pObj) == NULL)
+      c.push_back(pObj);
+
+    if (tried > 0 &&
+        (Deadline::now() >= end || (deadline != NULL && deadline->expired())))
+      stopped = true;
+  }
+
+  Aig_Man_t* pNew = Aig_ManStart(Aig_ManObjNumMax(p));
+  Aig_ManCleanData(p);
+  Aig_ManConst1(p)->pData = Aig_ManConst1(pNew);
+  for (int i = 0; i < Aig_ManPiNum(p); i++)
+    Aig_ManPi(p, i)->pData = Aig_ObjCreatePi(pNew);
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    Aig_Obj_t* pObj = nodes[i];
+    Aig_Obj_t* r = s.representative(pObj);
+    if (r != NULL)
+      pObj->pData =
+          Aig_NotCond((Aig_Obj_t*)Aig_Regular(r)->pData, Aig_IsComplement(r));
+    else
+      pObj->pData =
+          Aig_And(pNew, Aig_ObjChild0Copy(pObj), Aig_ObjChild1Copy(pObj));
+  }
+  for (int i = 0; i < Aig_ManPoNum(p); i++)
+    Aig_ObjCreatePo(pNew, Aig_ObjChild0Copy(Aig_ManPo(p, i)));
+  Aig_ManCleanup(pNew);
+  merged = s.proved;
+
+  if (uf.stats_flag)
+    std::cerr << "AIG sweep: " << Aig_ManNodeNum(p) << " -> "
+              << Aig_ManNodeNum(pNew) << " nodes, " << s.proved
+              << " merged, " << s.disproved << " disproved, " << s.undecided
+              << " undecided in " << (Deadline::now() - start) << "ms"
+              << (stopped ? ", stopped early" : "") << std::endl;
+
+  return pNew;
+}
+}
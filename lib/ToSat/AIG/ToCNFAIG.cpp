@@ -22,7 +22,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
 
+
 #include "stp/ToSat/AIG/ToCNFAIG.h"
+#include "stp/ToSat/AIG/AIGSweeper.h"
 
 namespace stp
 {
@@ -56,52 +58,141 @@ void addVariables(BBNodeManagerAIG& mgr, Cnf_Dat_t*& cnfData,
   }
 }
 
+namespace
+{
+// Stops a rewriting step once it has had its time, or once the query has.
+// ABC can't be unwound by an exception, so the deadline is only thrown for
+// between steps.
+struct StepBudget
+{
+  long end;
+  const Deadline* deadline;
+  bool stopped;
+
+  static int stop(void* data)
+  {
+    StepBudget* b = (StepBudget*)data;
+    if (Deadline::now() >= b->end ||
+        (b->deadline != NULL && b->deadline->expired()))
+      b->stopped = true;
+    return b->stopped ? 1 : 0;
+  }
+};
+}
+
+// Runs uf.aig_rewrite_steps. For mul63bit.smt2, three rounds of rewriting
+// with nCutsMax = 8 took 139 seconds, solving 10 seconds, so each step has
+// a time budget, and none run on very large AIGs.
 void ToCNFAIG::dag_aware_aig_rewrite(
   const bool needAbsRef,
   BBNodeManagerAIG& mgr)
 {
-  const int nodeCount = mgr.aigMgr->nObjs[AIG_OBJ_AND];
+  rewrite_steps = 0;
+  rewrite_removed = 0;
+  if (needAbsRef || !uf.enable_AIG_rewrites_flag)
+    return;
+
+  Dar_LibStart();
 
-  if (!needAbsRef && uf.enable_AIG_rewrites_flag)
+  for (size_t i = 0; i < uf.aig_rewrite_steps.size(); i++)
   {
-    Dar_LibStart();
-    Aig_Man_t* pTemp;
-    Dar_RwrPar_t Pars, *pPars = &Pars;
-    Dar_ManDefaultRwrParams(pPars);
+    const UserDefinedFlags::AIGRewriteStep step = uf.aig_rewrite_steps[i];
+    const char* name = UserDefinedFlags::aigRewriteStepName(step);
 
-    // Assertion errors occur with this enabled.
-    // pPars->fUseZeros = 1;
+    if (deadline != NULL)
+      deadline->checkNow();
 
-    // For mul63bit.smt2 with iterations =3 & nCutsMax = 8
-    // CNF generation was taking 139 seconds, solving 10 seconds.
+    const int before = mgr.aigMgr->nObjs[AIG_OBJ_AND];
+    if (before > uf.aig_rewrite_max_nodes)
+    {
+      if (uf.stats_flag)
+        cerr << "AIG " << name << ": skipped, " << before << " nodes" << endl;
+      continue;
+    }
 
-    // With nCutsMax =2, CNF generation takes 16 seconds, solving 10 seconds.
-    // The rewriting doesn't remove as many nodes of course..
-    const int iterations = 3;
+    const long start = Deadline::now();
+    StepBudget budget;
+    budget.end = start + uf.aig_rewrite_step_ms;
+    budget.deadline = deadline;
+    budget.stopped = false;
 
-    for (int i = 0; i < iterations; i++)
+    Aig_Man_t* pTemp;
+    if (step == UserDefinedFlags::REWRITE_STEP)
     {
+      // Assertion errors occur with fUseZeros enabled.
+      Dar_RwrPar_t pars;
+      Dar_ManDefaultRwrParams(&pars);
+      pars.pfStop = StepBudget::stop;
+      pars.pStopData = &budget;
+
+      mgr.aigMgr = Aig_ManDup(pTemp = mgr.aigMgr, 0);
+      Aig_ManStop(pTemp);
+      Dar_ManRewrite(mgr.aigMgr, &pars);
       mgr.aigMgr = Aig_ManDup(pTemp = mgr.aigMgr, 0);
       Aig_ManStop(pTemp);
-      Dar_ManRewrite(mgr.aigMgr, pPars);
+    }
+    else if (step == UserDefinedFlags::REFACTOR_STEP)
+    {
+      Dar_RefPar_t pars;
+      Dar_ManDefaultRefParams(&pars);
+      pars.pfStop = StepBudget::stop;
+      pars.pStopData = &budget;
 
       mgr.aigMgr = Aig_ManDup(pTemp = mgr.aigMgr, 0);
       Aig_ManStop(pTemp);
+      Dar_ManRefactor(mgr.aigMgr, &pars);
+      mgr.aigMgr = Aig_ManDup(pTemp = mgr.aigMgr, 0);
+      Aig_ManStop(pTemp);
+    }
+    else
+    {
+      assert(step == UserDefinedFlags::BALANCE_STEP);
+      // A single pass, so it isn't stopped early.
+      mgr.aigMgr = Dar_ManBalance(pTemp = mgr.aigMgr, 0);
+      Aig_ManStop(pTemp);
+    }
 
-      if (uf.stats_flag)
-        cerr << "After rewrite [" << i
-             << "]  nodes:" << mgr.aigMgr->nObjs[AIG_OBJ_AND] << endl;
+    const int after = mgr.aigMgr->nObjs[AIG_OBJ_AND];
+    rewrite_steps++;
+    if (after < before)
+      rewrite_removed += before - after;
 
-      //Fixedpoint reached?
-      if (nodeCount == mgr.aigMgr->nObjs[AIG_OBJ_AND])
-        break;
+    if (uf.stats_flag)
+    {
+      cerr << "AIG " << name << ": " << before << " -> " << after
+           << " nodes (" << (before - after) << " fewer) in "
+           << (Deadline::now() - start) << "ms"
+           << (budget.stopped ? ", stopped early" : "") << endl;
     }
   }
 }
 
+// Like rewriting, the AIG is replaced, so it's not done when the AIG is
+// kept for refinement.
+void ToCNFAIG::sat_sweep(const bool needAbsRef, BBNodeManagerAIG& mgr)
+{
+  sweep_merged = 0;
+  if (needAbsRef || !uf.aig_sweep_flag)
+    return;
+
+  const int nodes = Aig_ManNodeNum(mgr.aigMgr);
+  if (nodes > uf.aig_sweep_max_nodes || Aig_ManExorNum(mgr.aigMgr) > 0)
+  {
+    if (uf.stats_flag)
+      cerr << "AIG sweep: skipped, " << nodes << " nodes" << endl;
+    return;
+  }
+
+  AIGSweeper sweeper(uf, deadline);
+  Aig_Man_t* pTemp = mgr.aigMgr;
+  mgr.aigMgr = sweeper.sweep(pTemp);
+  Aig_ManStop(pTemp);
+  sweep_merged = sweeper.getMerged();
+}
+
 void ToCNFAIG::toCNF(const BBNodeAIG& top, Cnf_Dat_t*& cnfData,
                      ToSATBase::ASTNodeToSATVar& nodeToVars, bool needAbsRef,
-                     BBNodeManagerAIG& mgr)
+                     BBNodeManagerAIG& mgr, Cnf_Sink_t* sink)
 {
   assert(cnfData == NULL);
 
@@ -125,9 +216,20 @@ void ToCNFAIG::toCNF(const BBNodeAIG& top, Cnf_Dat_t*& cnfData,
 
   dag_aware_aig_rewrite(needAbsRef, mgr);
 
+  if (deadline != NULL)
+    deadline->checkNow();
+
+  sat_sweep(needAbsRef, mgr);
+
+  if (deadline != NULL)
+    deadline->checkNow();
+
   if (!uf.simple_cnf)
   {
-    cnfData = Cnf_Derive(mgr.aigMgr, 0);
+    if (sink != NULL)
+      cnfData = Cnf_DeriveToSink(mgr.aigMgr, 0, sink);
+    else
+      cnfData = Cnf_Derive(mgr.aigMgr, 0);
     if (uf.stats_flag)
       cerr << "advanced CNF" << endl;
   }
@@ -136,6 +238,15 @@ void ToCNFAIG::toCNF(const BBNodeAIG& top, Cnf_Dat_t*& cnfData,
     cnfData = Cnf_DeriveSimple(mgr.aigMgr, 0);
     if (uf.stats_flag)
       cerr << "simple CNF" << endl;
+
+    // The simple CNF is small, so it's built whole and then handed over.
+    if (sink != NULL)
+    {
+      sink->pfNewVars(sink->pData, cnfData->nVars);
+      for (int i = 0; i < cnfData->nClauses; i++)
+        sink->pfAddClause(sink->pData, cnfData->pClauses[i],
+                          cnfData->pClauses[i + 1] - cnfData->pClauses[i]);
+    }
   }
   assert(cnfData != NULL);
 
@@ -29,7 +29,7 @@ THE SOFTWARE.
 namespace stp
 {
 
-int ToSATAIG::cnf_calls = 0;
+thread_local int ToSATAIG::cnf_calls = 0;
 
 bool ToSATAIG::CallSAT(SATSolver& satSolver, const ASTNode& input,
                        bool needAbsRef)
@@ -39,7 +39,9 @@ bool ToSATAIG::CallSAT(SATSolver& satSolver, const ASTNode& input,
 
   if (!first)
   {
-    assert(input == ASTTrue);
+    assert(input == ASTTrue || canAddFormulas());
+    if (input != ASTTrue && !addFormula(satSolver, input))
+      return false;
     return runSolver(satSolver);
   }
 
@@ -53,11 +55,17 @@ bool ToSATAIG::CallSAT(SATSolver& satSolver, const ASTNode& input,
     return true;
 
   first = false;
-  Cnf_Dat_t* cnfData = bitblast(input, needAbsRef);
+  assert(satSolver.nVars() == 0);
+
+  // Unless the CNF is to be written out, the clauses go into the solver as
+  // ABC derives them, so the whole CNF is never held as well.
+  const bool stream =
+      bm->UserFlags.cnf_streaming_flag && !bm->UserFlags.output_CNF_flag;
+  Cnf_Dat_t* cnfData = bitblast(input, needAbsRef, stream ? &satSolver : NULL);
   handle_cnf_options(cnfData, needAbsRef);
 
-  assert(satSolver.nVars() == 0);
-  add_cnf_to_solver(satSolver, cnfData);
+  if (!stream)
+    add_cnf_to_solver(satSolver, cnfData);
 
   if (bm->UserFlags.output_bench_flag) {
     cerr << "Converting to CNF via ABC's AIG package can't yet print out bench "
@@ -66,6 +74,10 @@ bool ToSATAIG::CallSAT(SATSolver& satSolver, const ASTNode& input,
   release_cnf_memory(cnfData);
 
   mark_variables_as_frozen(satSolver);
+  // So the simplifying solvers don't eliminate what later formulas use.
+  for (size_t i = 0; i < aigToSATVar.size(); i++)
+    if (aigToSATVar[i] != -1)
+      satSolver.setFrozen(aigToSATVar[i]);
 
   return runSolver(satSolver);
 }
@@ -108,34 +120,268 @@ void ToSATAIG::handle_cnf_options(Cnf_Dat_t* cnfData, bool needAbsRef)
   }
 }
 
-Cnf_Dat_t* ToSATAIG::bitblast(const ASTNode& input, bool needAbsRef)
+namespace
 {
-  Simplifier simp(bm);
+// Receives the clauses from ABC. The variables are all made before the
+// first clause arrives, and the clause vector is reused.
+struct SolverSink
+{
+  SATSolver& solver;
+  SATSolver::vec_literals clause;
+
+  explicit SolverSink(SATSolver& s) : solver(s) {}
+
+  static void newVars(void* data, int nVars)
+  {
+    SATSolver& solver = ((SolverSink*)data)->solver;
+    for (int i = solver.nVars(); i < nVars; i++)
+      solver.newVar();
+  }
+
+  static void addClause(void* data, int* lits, int nLits)
+  {
+    SolverSink* sink = (SolverSink*)data;
+    // Once it's unsatisfiable the rest don't matter.
+    if (!sink->solver.okay())
+      return;
+
+    sink->clause.clear();
+    for (int i = 0; i < nLits; i++)
+    {
+      assert((uint32_t)(lits[i] >> 1) < sink->solver.nVars());
+      sink->clause.push(SATSolver::mkLit(lits[i] >> 1, lits[i] & 1));
+    }
+    sink->solver.addClause(sink->clause);
+  }
+};
+}
 
-  BBNodeManagerAIG mgr;
-  BitBlaster<BBNodeAIG, BBNodeManagerAIG> bb(
-      &mgr, &simp, bm->defaultNodeFactory, &bm->UserFlags, cb);
+Cnf_Dat_t* ToSATAIG::bitblast(const ASTNode& input, bool needAbsRef,
+                              SATSolver* streamTo)
+{
+  std::unique_ptr<Simplifier> simp(new Simplifier(bm));
+  std::unique_ptr<BBNodeManagerAIG> mgr(new BBNodeManagerAIG());
+  std::unique_ptr<BitBlaster<BBNodeAIG, BBNodeManagerAIG>> bb(
+      new BitBlaster<BBNodeAIG, BBNodeManagerAIG>(
+          mgr.get(), simp.get(), bm->defaultNodeFactory, &bm->UserFlags, cb));
+  bb->deadline = &bm->deadline;
 
   bm->GetRunTimes()->start(RunTimes::BitBlasting);
-  BBNodeAIG BBFormula = bb.BBForm(input);
+  // The workers don't use what constant bit propagation found, their
+  // nodes aren't the ones it knows about.
+  BBNodeAIG BBFormula;
+  if (bm->UserFlags.bitblast_threads < 2 || input.GetKind() != AND ||
+      !bitblast_parallel(input, *mgr, BBFormula))
+    BBFormula = bb->BBForm(input);
   bm->GetRunTimes()->stop(RunTimes::BitBlasting);
 
   delete cb;
   cb = NULL;
-  bb.cb = NULL;
+  bb->cb = NULL;
 
+  // When streaming, the time spent in the solver's addClause is counted
+  // as CNF conversion.
   bm->GetRunTimes()->start(RunTimes::CNFConversion);
   Cnf_Dat_t* cnfData = NULL;
-  toCNF.toCNF(BBFormula, cnfData, nodeToSATVar, needAbsRef, mgr);
+  if (streamTo != NULL)
+  {
+    SolverSink solverSink(*streamTo);
+    Cnf_Sink_t sink;
+    sink.pData = &solverSink;
+    sink.pfNewVars = SolverSink::newVars;
+    sink.pfAddClause = SolverSink::addClause;
+    toCNF.toCNF(BBFormula, cnfData, nodeToSATVar, needAbsRef, *mgr, &sink);
+  }
+  else
+    toCNF.toCNF(BBFormula, cnfData, nodeToSATVar, needAbsRef, *mgr);
   bm->GetRunTimes()->stop(RunTimes::CNFConversion);
+  if (toCNF.getSweepMerged() > 0)
+    bm->GetRunTimes()->addCount(RunTimes::AIGSweepMerge,
+                                toCNF.getSweepMerged());
+  if (toCNF.getRewriteSteps() > 0)
+    bm->GetRunTimes()->addCount(RunTimes::AIGRewriteStep,
+                                toCNF.getRewriteSteps());
+  if (toCNF.getRewriteRemoved() > 0)
+    bm->GetRunTimes()->addCount(RunTimes::AIGRewriteRemoved,
+                                toCNF.getRewriteRemoved());
 
-  // Free the memory in the AIGs.
   BBFormula = BBNodeAIG(); // null node
-  mgr.stop();
+
+  // With refinement there's no rewriting or clean up, so the node ids
+  // still match the CNF's variable numbers. Every node that the mapping
+  // gave a variable is defined by its clauses, so later formulas can
+  // start from it. They're frozen in CallSAT.
+  if (needAbsRef && bm->UserFlags.aig_refinement_flag)
+  {
+    Aig_Man_t* aig = mgr->aigMgr;
+    aigToSATVar.assign(cnfData->pVarNums,
+                       cnfData->pVarNums + Aig_ManObjNumMax(aig));
+
+    keptSimp = std::move(simp);
+    keptMgr = std::move(mgr);
+    keptBB = std::move(bb);
+  }
+  else
+  {
+    // Free the memory in the AIGs.
+    bb.reset();
+    mgr->stop();
+  }
 
   return cnfData;
 }
 
+bool ToSATAIG::addFormula(SATSolver& satSolver, const ASTNode& input)
+{
+  assert(canAddFormulas());
+
+  bm->GetRunTimes()->start(RunTimes::BitBlasting);
+  const BBNodeAIG top = keptBB->BBForm(input);
+  bm->GetRunTimes()->stop(RunTimes::BitBlasting);
+
+  if (top == keptMgr->getTrue())
+    return true;
+
+  if (top == keptMgr->getFalse())
+  {
+    SATSolver::vec_literals empty;
+    satSolver.addClause(empty);
+    return false;
+  }
+
+  bm->GetRunTimes()->start(RunTimes::CNFConversion);
+
+  // Copy the cone of "top" into an AIG of its own, stopping at the nodes
+  // that already have SAT variables. Those become the inputs of the copy.
+  Aig_Man_t* aig = keptMgr->aigMgr;
+  aigToSATVar.resize(Aig_ManObjNumMax(aig), -1);
+
+  Aig_Man_t* cone = Aig_ManStart(0);
+  vector<Aig_Obj_t*> copy(Aig_ManObjNumMax(aig), NULL);
+  copy[Aig_ManConst1(aig)->Id] = Aig_ManConst1(cone);
+
+  vector<int> inputVar; // The SAT variable of each input of the copy.
+  vector<Aig_Obj_t*> copied;
+  vector<Aig_Obj_t*> stack(1, Aig_Regular(top.n));
+  while (!stack.empty())
+  {
+    Aig_Obj_t* n = stack.back();
+    if (copy[n->Id] != NULL)
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if (Aig_ObjIsPi(n) || aigToSATVar[n->Id] != -1)
+    {
+      stack.pop_back();
+      // Part of a symbol that wasn't in the first formula.
+      if (aigToSATVar[n->Id] == -1)
+      {
+        aigToSATVar[n->Id] = satSolver.newVar();
+        satSolver.setFrozen(aigToSATVar[n->Id]);
+      }
+      copy[n->Id] = Aig_ObjCreatePi(cone);
+      inputVar.push_back(aigToSATVar[n->Id]);
+      continue;
+    }
+
+    assert(Aig_ObjIsAnd(n));
+    Aig_Obj_t* f0 = Aig_ObjFanin0(n);
+    Aig_Obj_t* f1 = Aig_ObjFanin1(n);
+    if (copy[f0->Id] == NULL || copy[f1->Id] == NULL)
+    {
+      if (copy[f0->Id] == NULL)
+        stack.push_back(f0);
+      if (copy[f1->Id] == NULL)
+        stack.push_back(f1);
+      continue;
+    }
+    stack.pop_back();
+
+    copy[n->Id] =
+        Aig_And(cone, Aig_NotCond(copy[f0->Id], Aig_ObjFaninC0(n)),
+                Aig_NotCond(copy[f1->Id], Aig_ObjFaninC1(n)));
+    copied.push_back(n);
+  }
+  Aig_ObjCreatePo(cone, Aig_NotCond(copy[Aig_Regular(top.n)->Id],
+                                    Aig_IsComplement(top.n)));
+  assert(Aig_ManCheck(cone));
+
+  Cnf_Dat_t* cnfData = bm->UserFlags.simple_cnf ? Cnf_DeriveSimple(cone, 0)
+                                                 : Cnf_Derive(cone, 0);
+
+  // The inputs keep their variables, everything else gets a new one.
+  vector<int> toSolver(cnfData->nVars, -1);
+  for (size_t i = 0; i < inputVar.size(); i++)
+  {
+    Aig_Obj_t* pObj = (Aig_Obj_t*)Vec_PtrEntry(cone->vPis, i);
+    if (cnfData->pVarNums[pObj->Id] != -1)
+      toSolver[cnfData->pVarNums[pObj->Id]] = inputVar[i];
+  }
+  for (int i = 1; i < cnfData->nVars; i++)
+    if (toSolver[i] == -1)
+      toSolver[i] = satSolver.newVar();
+
+  // Later formulas can refer to the nodes that were given variables.
+  for (size_t i = 0; i < copied.size(); i++)
+  {
+    Aig_Obj_t* c = copy[copied[i]->Id];
+    if (Aig_IsComplement(c) || cnfData->pVarNums[c->Id] == -1)
+      continue;
+    aigToSATVar[copied[i]->Id] = toSolver[cnfData->pVarNums[c->Id]];
+    satSolver.setFrozen(aigToSATVar[copied[i]->Id]);
+  }
+
+  SATSolver::vec_literals satSolverClause;
+  for (int i = 0; i < cnfData->nClauses && satSolver.okay(); i++)
+  {
+    satSolverClause.clear();
+    for (int* pLit = cnfData->pClauses[i], *pStop = cnfData->pClauses[i + 1];
+         pLit < pStop; pLit++)
+      satSolverClause.push(
+          SATSolver::mkLit(toSolver[(*pLit) >> 1], (*pLit) & 1));
+    satSolver.addClause(satSolverClause);
+  }
+
+  Cnf_DataFree(cnfData);
+  Aig_ManStop(cone);
+
+  update_node_to_var();
+  bm->GetRunTimes()->stop(RunTimes::CNFConversion);
+
+  return true;
+}
+
+// Adds the variables given to symbols since the first CNF was made.
+void ToSATAIG::update_node_to_var()
+{
+  BBNodeManagerAIG::SymbolToBBNode::const_iterator it;
+  for (it = keptMgr->symbolToBBNode.begin();
+       it != keptMgr->symbolToBBNode.end(); it++)
+  {
+    const ASTNode& n = it->first;
+    const vector<BBNodeAIG>& b = it->second;
+
+    vector<unsigned>& v = nodeToSATVar[n];
+    if (v.empty())
+    {
+      const int width = (n.GetType() == BOOLEAN_TYPE) ? 1 : n.GetValueWidth();
+      v.resize(width, ~((unsigned)0));
+    }
+
+    for (unsigned i = 0; i < b.size() && i < v.size(); i++)
+    {
+      if (b[i].IsNull())
+        continue;
+      const int id = Aig_Regular(b[i].n)->Id;
+      if (v[i] == ~((unsigned)0) && id < (int)aigToSATVar.size() &&
+          aigToSATVar[id] != -1)
+        v[i] = aigToSATVar[id];
+    }
+  }
+}
+
 void ToSATAIG::add_cnf_to_solver(SATSolver& satSolver, Cnf_Dat_t* cnfData)
 {
   bm->GetRunTimes()->start(RunTimes::SendingToSAT);
@@ -0,0 +1,317 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/ToSat/AIG/ToSATAIGIncremental.h"
+#include "stp/Util/RunTimes.h"
+
+namespace stp
+{
+
+ToSATAIGIncremental::ToSATAIGIncremental(STPMgr* bm)
+    : ToSATBase(bm), simp(bm), solver(NULL)
+{
+  reset();
+}
+
+ToSATAIGIncremental::~ToSATAIGIncremental()
+{
+  ClearAllTables();
+}
+
+// Throws away the AIG and what's known about it, but not the solver. The
+// clauses already in the solver only define variables that nothing refers
+// to any more, so they can't change the answer to later queries.
+void ToSATAIGIncremental::reset()
+{
+  bb.reset();
+  mgr.reset(new BBNodeManagerAIG());
+  bb.reset(new BitBlaster<BBNodeAIG, BBNodeManagerAIG>(
+      mgr.get(), &simp, bm->defaultNodeFactory, &bm->UserFlags));
+  bb->deadline = &bm->deadline;
+  aigToSATVar.clear();
+  symbolWidth.clear();
+}
+
+// Returns false if one of the symbols has changed width since it was last
+// bit-blasted.
+bool ToSATAIGIncremental::collectSymbols(const ASTVec& roots,
+                                         ASTVec& symbols)
+{
+  bool ok = true;
+  ASTNodeSet visited;
+  ASTVec stack(roots);
+  while (!stack.empty())
+  {
+    const ASTNode n = stack.back();
+    stack.pop_back();
+    if (!visited.insert(n).second)
+      continue;
+
+    if (n.GetKind() == SYMBOL)
+    {
+      symbols.push_back(n);
+      ASTNodeToWidth::iterator it = symbolWidth.find(n);
+      if (it == symbolWidth.end())
+        symbolWidth.insert(std::make_pair(n, n.GetValueWidth()));
+      else if (it->second != n.GetValueWidth())
+        ok = false;
+    }
+
+    const ASTVec& c = n.GetChildren();
+    stack.insert(stack.end(), c.begin(), c.end());
+  }
+  return ok;
+}
+
+int ToSATAIGIncremental::getSATVar(SATSolver& satSolver, Aig_Obj_t* n)
+{
+  assert(!Aig_IsComplement(n));
+  if ((size_t)n->Id >= aigToSATVar.size())
+    aigToSATVar.resize(n->Id + 1, -1);
+
+  if (aigToSATVar[n->Id] == -1)
+  {
+    aigToSATVar[n->Id] = satSolver.newVar();
+    satSolver.setFrozen(aigToSATVar[n->Id]);
+  }
+  return aigToSATVar[n->Id];
+}
+
+// Adds the definitions of any nodes under "root" that the solver doesn't
+// have yet, and returns the literal that is equivalent to "root".
+Minisat::Lit ToSATAIGIncremental::encode(SATSolver& satSolver,
+                                         Aig_Obj_t* root)
+{
+  vector<Aig_Obj_t*> stack;
+  stack.push_back(Aig_Regular(root));
+
+  SATSolver::vec_literals clause;
+  while (!stack.empty())
+  {
+    Aig_Obj_t* n = stack.back();
+
+    if ((size_t)n->Id < aigToSATVar.size() && aigToSATVar[n->Id] != -1)
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if (Aig_ObjIsConst1(n))
+    {
+      stack.pop_back();
+      const int v = getSATVar(satSolver, n);
+      clause.clear();
+      clause.push(SATSolver::mkLit(v, false));
+      satSolver.addClause(clause);
+      continue;
+    }
+
+    if (Aig_ObjIsPi(n))
+    {
+      stack.pop_back();
+      getSATVar(satSolver, n);
+      continue;
+    }
+
+    assert(Aig_ObjIsAnd(n));
+    Aig_Obj_t* f0 = Aig_ObjFanin0(n);
+    Aig_Obj_t* f1 = Aig_ObjFanin1(n);
+    const bool f0Done =
+        (size_t)f0->Id < aigToSATVar.size() && aigToSATVar[f0->Id] != -1;
+    const bool f1Done =
+        (size_t)f1->Id < aigToSATVar.size() && aigToSATVar[f1->Id] != -1;
+    if (!f0Done || !f1Done)
+    {
+      if (!f0Done)
+        stack.push_back(f0);
+      if (!f1Done)
+        stack.push_back(f1);
+      continue;
+    }
+    stack.pop_back();
+
+    // n <-> (a & b)
+    const Minisat::Lit a =
+        SATSolver::mkLit(aigToSATVar[f0->Id], Aig_ObjFaninC0(n));
+    const Minisat::Lit b =
+        SATSolver::mkLit(aigToSATVar[f1->Id], Aig_ObjFaninC1(n));
+    const int v = getSATVar(satSolver, n);
+
+    clause.clear();
+    clause.push(SATSolver::mkLit(v, true));
+    clause.push(a);
+    satSolver.addClause(clause);
+
+    clause.clear();
+    clause.push(SATSolver::mkLit(v, true));
+    clause.push(b);
+    satSolver.addClause(clause);
+
+    clause.clear();
+    clause.push(SATSolver::mkLit(v, false));
+    clause.push(~a);
+    clause.push(~b);
+    satSolver.addClause(clause);
+  }
+
+  return SATSolver::mkLit(aigToSATVar[Aig_Regular(root)->Id],
+                          Aig_IsComplement(root));
+}
+
+void ToSATAIGIncremental::fill_node_to_var(const ASTVec& symbols)
+{
+  nodeToSATVar.clear();
+  for (size_t i = 0; i < symbols.size(); i++)
+  {
+    const ASTNode& n = symbols[i];
+    const int width = (n.GetType() == BOOLEAN_TYPE) ? 1 : n.GetValueWidth();
+
+    // ~0 for parts of symbols that didn't get encoded.
+    vector<unsigned> v(width, ~((unsigned)0));
+
+    BBNodeManagerAIG::SymbolToBBNode::const_iterator it =
+        mgr->symbolToBBNode.find(n);
+    if (it != mgr->symbolToBBNode.end())
+    {
+      const vector<BBNodeAIG>& b = it->second;
+      for (unsigned j = 0; j < b.size() && j < v.size(); j++)
+      {
+        if (b[j].IsNull())
+          continue;
+        Aig_Obj_t* pObj = Aig_Regular(b[j].n);
+        if ((size_t)pObj->Id < aigToSATVar.size() &&
+            aigToSATVar[pObj->Id] != -1)
+          v[j] = aigToSATVar[pObj->Id];
+      }
+    }
+    nodeToSATVar.insert(make_pair(n, v));
+  }
+}
+
+bool ToSATAIGIncremental::CallSAT(SATSolver& satSolver, const ASTNode& input,
+                                  bool needAbsRef)
+{
+  assert(!needAbsRef);
+  assert(solver == NULL || solver == &satSolver);
+  solver = &satSolver;
+
+  ASTVec assumed;
+  assumed.swap(assumptions);
+  failed.clear();
+
+  if (!satSolver.okay())
+    return false;
+
+  if (input == ASTFalse)
+    return false;
+
+  ASTVec roots(assumed);
+  roots.push_back(input);
+  ASTVec symbols;
+  if (!collectSymbols(roots, symbols))
+  {
+    reset();
+    symbols.clear();
+    collectSymbols(roots, symbols);
+  }
+
+  ASTVec conjuncts;
+  if (input.GetKind() == AND)
+    conjuncts = FlattenKind(AND, input.GetChildren());
+  else
+    conjuncts.push_back(input);
+
+  bm->GetRunTimes()->start(RunTimes::BitBlasting);
+  vector<BBNodeAIG> bbConjuncts;
+  bool isFalse = false;
+  for (size_t i = 0; i < conjuncts.size() && !isFalse; i++)
+  {
+    const BBNodeAIG r = bb->BBForm(conjuncts[i]);
+    if (r == mgr->getFalse())
+      isFalse = true;
+    else if (r != mgr->getTrue())
+      bbConjuncts.push_back(r);
+  }
+
+  vector<BBNodeAIG> bbAssumed(assumed.size());
+  for (size_t i = 0; i < assumed.size() && !isFalse; i++)
+  {
+    bbAssumed[i] = bb->BBForm(assumed[i]);
+    if (bbAssumed[i] == mgr->getFalse())
+    {
+      failed.push_back(i);
+      isFalse = true;
+    }
+  }
+  bm->GetRunTimes()->stop(RunTimes::BitBlasting);
+
+  if (isFalse)
+    return false;
+
+  bm->GetRunTimes()->start(RunTimes::CNFConversion);
+  SATSolver::vec_literals lits;
+  for (size_t i = 0; i < bbConjuncts.size(); i++)
+    lits.push(encode(satSolver, bbConjuncts[i].n));
+
+  // Where each assumption's literal is in lits, -1 if it's trivially true.
+  vector<int> assumedLit(assumed.size(), -1);
+  for (size_t i = 0; i < assumed.size(); i++)
+  {
+    if (bbAssumed[i] == mgr->getTrue())
+      continue;
+    assumedLit[i] = lits.size();
+    lits.push(encode(satSolver, bbAssumed[i].n));
+  }
+  fill_node_to_var(symbols);
+  bm->GetRunTimes()->stop(RunTimes::CNFConversion);
+
+  if (!satSolver.okay())
+    return false;
+
+  bm->GetRunTimes()->start(RunTimes::Solving);
+  const bool result =
+      satSolver.solveWithAssumptions(lits, bm->soft_timeout_expired);
+  bm->GetRunTimes()->stop(RunTimes::Solving);
+
+  if (bm->UserFlags.stats_flag)
+    satSolver.printStats();
+
+  if (!result && !bm->soft_timeout_expired && !assumed.empty())
+  {
+    SATSolver::vec_literals conflict;
+    satSolver.getFailedAssumptions(conflict);
+    std::set<int> inConflict;
+    for (int i = 0; i < conflict.size(); i++)
+      inConflict.insert(Minisat::toInt(conflict[i]));
+
+    for (size_t i = 0; i < assumed.size(); i++)
+      if (assumedLit[i] != -1 &&
+          inConflict.count(Minisat::toInt(lits[assumedLit[i]])) > 0)
+        failed.push_back(i);
+  }
+
+  return result;
+}
+}
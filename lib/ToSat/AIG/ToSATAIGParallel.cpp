@@ -0,0 +1,268 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/ToSat/AIG/ToSATAIG.h"
+#include "stp/AST/NodeFactory/SimplifyingNodeFactory.h"
+#include "stp/Simplifier/Simplifier.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace stp
+{
+
+namespace
+{
+
+// Bit-blasts some of the conjuncts into an AIG manager of its own. Nodes
+// can't be shared between threads, so it has its own copy of them too.
+struct BitBlastWorker
+{
+  std::unique_ptr<STPMgr> mgr;
+  std::unique_ptr<SimplifyingNodeFactory> nf;
+  std::unique_ptr<Simplifier> simp;
+  BBNodeManagerAIG aig;
+
+  ASTVec conjuncts;
+
+  // From this worker's symbols to the caller's.
+  ASTNodeMap toCaller;
+
+  BBNodeAIG result;
+  std::exception_ptr error;
+
+  BitBlastWorker() : mgr(new STPMgr())
+  {
+    nf.reset(new SimplifyingNodeFactory(*mgr->hashingNodeFactory, *mgr));
+    mgr->defaultNodeFactory = nf.get();
+    simp.reset(new Simplifier(mgr.get()));
+  }
+
+  ~BitBlastWorker()
+  {
+    conjuncts.clear();
+    toCaller.clear();
+    simp.reset();
+    mgr->defaultNodeFactory = mgr->hashingNodeFactory;
+    nf.reset();
+  }
+
+  void run()
+  {
+    try
+    {
+      BitBlaster<BBNodeAIG, BBNodeManagerAIG> bb(
+          &aig, simp.get(), mgr->defaultNodeFactory, &mgr->UserFlags);
+      bb.deadline = &mgr->deadline;
+
+      const ASTNode form =
+          conjuncts.size() == 1
+              ? conjuncts[0]
+              : mgr->defaultNodeFactory->CreateNode(AND, conjuncts);
+      result = bb.BBForm(form);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+  }
+};
+
+// Groups the conjuncts so that no symbol is in two groups, then shares the
+// groups out between at most "threads" bins, biggest first. If everything
+// is connected, the conjuncts are shared out one by one instead, and the
+// terms they have in common get bit-blasted more than once.
+vector<ASTVec> partitionConjuncts(const ASTVec& conjuncts, int threads)
+{
+  const size_t n = conjuncts.size();
+
+  vector<size_t> parent(n);
+  for (size_t i = 0; i < n; i++)
+    parent[i] = i;
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+
+  // Each node belongs to the first conjunct it's found under. Meeting it
+  // again from another conjunct joins the two.
+  std::unordered_map<ASTNode, size_t, ASTNode::ASTNodeHasher,
+                     ASTNode::ASTNodeEqual> owner;
+  vector<size_t> size(n, 0);
+  for (size_t i = 0; i < n; i++)
+  {
+    ASTVec stack(1, conjuncts[i]);
+    while (!stack.empty())
+    {
+      const ASTNode node = stack.back();
+      stack.pop_back();
+      if (node.isConstant())
+        continue;
+
+      auto it = owner.find(node);
+      if (it != owner.end())
+      {
+        parent[find(it->second)] = find(i);
+        continue;
+      }
+      owner.insert(std::make_pair(node, i));
+      size[i]++;
+
+      const ASTVec& c = node.GetChildren();
+      stack.insert(stack.end(), c.begin(), c.end());
+    }
+  }
+
+  std::map<size_t, vector<size_t>> components;
+  for (size_t i = 0; i < n; i++)
+    components[find(i)].push_back(i);
+
+  vector<vector<size_t>> units;
+  if (components.size() > 1)
+    for (auto& c : components)
+      units.push_back(c.second);
+  else
+    for (size_t i = 0; i < n; i++)
+      units.push_back(vector<size_t>(1, i));
+
+  vector<std::pair<size_t, size_t>> weights; // (size, unit)
+  for (size_t u = 0; u < units.size(); u++)
+  {
+    size_t w = 0;
+    for (size_t i : units[u])
+      w += size[i];
+    weights.push_back(std::make_pair(w, u));
+  }
+  std::sort(weights.rbegin(), weights.rend());
+
+  const size_t bins = std::min(units.size(), (size_t)threads);
+  vector<ASTVec> result(bins);
+  vector<size_t> load(bins, 0);
+  for (const auto& w : weights)
+  {
+    const size_t b = std::min_element(load.begin(), load.end()) - load.begin();
+    load[b] += w.first;
+    for (size_t i : units[w.second])
+      result[b].push_back(conjuncts[i]);
+  }
+  return result;
+}
+}
+
+// The caller's STPMgr and AIG manager are only used from this thread. Each
+// group of conjuncts is copied into a worker before the threads start, and
+// the workers' AIGs are copied into "mgr" after they've all finished. The
+// copies of the same symbol bit become the same primary input, so
+// fill_node_to_var sees the same symbols as it would have done.
+bool ToSATAIG::bitblast_parallel(const ASTNode& input, BBNodeManagerAIG& mgr,
+                                 BBNodeAIG& result)
+{
+  assert(input.GetKind() == AND);
+
+  const vector<ASTVec> groups =
+      partitionConjuncts(input.GetChildren(), bm->UserFlags.bitblast_threads);
+  if (groups.size() < 2)
+    return false;
+
+  std::vector<std::unique_ptr<BitBlastWorker>> workers;
+  for (size_t i = 0; i < groups.size(); i++)
+  {
+    BitBlastWorker* w = new BitBlastWorker();
+    workers.push_back(std::unique_ptr<BitBlastWorker>(w));
+
+    w->mgr->UserFlags = bm->UserFlags;
+    w->mgr->UserFlags.bitblast_threads = 0;
+    w->mgr->deadline = bm->deadline;
+
+    ASTNodeMap copied;
+    for (size_t j = 0; j < groups[i].size(); j++)
+      w->conjuncts.push_back(w->mgr->ImportNode(groups[i][j], copied));
+
+    for (ASTNodeMap::const_iterator it = copied.begin(); it != copied.end();
+         it++)
+      if (it->first.GetKind() == SYMBOL)
+        w->toCaller.insert(std::make_pair(it->second, it->first));
+  }
+
+  std::vector<std::thread> running;
+  for (size_t i = 0; i < workers.size(); i++)
+    running.push_back(std::thread(&BitBlastWorker::run, workers[i].get()));
+  for (size_t i = 0; i < running.size(); i++)
+    running[i].join();
+
+  for (size_t i = 0; i < workers.size(); i++)
+    if (workers[i]->error)
+      std::rethrow_exception(workers[i]->error);
+
+  vector<BBNodeAIG> outputs;
+  for (size_t w = 0; w < workers.size(); w++)
+  {
+    BitBlastWorker& worker = *workers[w];
+    Aig_Man_t* from = worker.aig.aigMgr;
+
+    Aig_ManCleanData(from);
+    Aig_ManConst1(from)->pData = Aig_ManConst1(mgr.aigMgr);
+
+    for (BBNodeManagerAIG::SymbolToBBNode::const_iterator it =
+             worker.aig.symbolToBBNode.begin();
+         it != worker.aig.symbolToBBNode.end(); it++)
+    {
+      const ASTNode& symbol = worker.toCaller.find(it->first)->second;
+      const vector<BBNodeAIG>& bits = it->second;
+      for (unsigned i = 0; i < bits.size(); i++)
+        if (!bits[i].IsNull())
+          bits[i].n->pData = mgr.CreateSymbol(symbol, i).n;
+    }
+
+    // Objects are numbered in the order they were made, so each node's
+    // fanins have been copied before it is.
+    for (int i = 0; i < Aig_ManObjNumMax(from); i++)
+    {
+      Aig_Obj_t* obj = Aig_ManObj(from, i);
+      if (obj == NULL || !Aig_ObjIsNode(obj))
+        continue;
+
+      Aig_Obj_t* c0 = Aig_ObjChild0Copy(obj);
+      Aig_Obj_t* c1 = Aig_ObjChild1Copy(obj);
+      obj->pData = Aig_ObjIsExor(obj) ? Aig_Exor(mgr.aigMgr, c0, c1)
+                                      : Aig_And(mgr.aigMgr, c0, c1);
+    }
+
+    Aig_Obj_t* r = worker.result.n;
+    outputs.push_back(BBNodeAIG(Aig_NotCond(
+        (Aig_Obj_t*)Aig_Regular(r)->pData, Aig_IsComplement(r))));
+  }
+
+  if (bm->UserFlags.stats_flag)
+    std::cerr << "Bit-blasted " << input.Degree() << " conjuncts on "
+              << workers.size() << " threads." << std::endl;
+
+  result = mgr.CreateNode(AND, outputs);
+  return true;
+}
+
+} // end of namespace
@@ -21,6 +21,7 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include "stp/ToSat/BitBlaster.h"
@@ -54,7 +55,6 @@ using simplifier::constantBitP::NodeToFixedBitsMap;
 using std::make_pair;
 
 #define BBNodeVec vector<BBNode>
-#define BBNodeVecMap std::map<ASTNode, vector<BBNode>>
 #define BBNodeSet std::set<BBNode>
 
 vector<BBNodeAIG> _empty_BBNodeAIGVec;
@@ -118,12 +118,23 @@ void BitBlaster<BBNode, BBNodeManagerT>::getConsts(const ASTNode& form,
   BBForm(form, support);
   assert(support.size() == 0);
 
+  // The memos are hashed. Visit them in node order, so that which of several
+  // equivalent nodes is found first doesn't depend on the hash layout.
+  ASTVec forms, terms;
+  forms.reserve(BBFormMemo.size());
+  for (const auto& e : BBFormMemo)
+    forms.push_back(e.first);
+  std::sort(forms.begin(), forms.end());
+  terms.reserve(BBTermMemo.size());
+  for (const auto& e : BBTermMemo)
+    terms.push_back(e.first);
+  std::sort(terms.begin(), terms.end());
+
   {
-    typename std::map<ASTNode, BBNode>::iterator it;
-    for (it = BBFormMemo.begin(); it != BBFormMemo.end(); it++)
+    for (size_t j = 0; j < forms.size(); j++)
     {
-      const ASTNode& n = it->first;
-      const BBNode& x = it->second;
+      const ASTNode& n = forms[j];
+      const BBNode& x = BBFormMemo.find(n)->second;
       if (n.isConstant())
         continue;
 
@@ -145,17 +156,17 @@ void BitBlaster<BBNode, BBNodeManagerT>::getConsts(const ASTNode& form,
     }
   }
 
-  typename BBNodeVecMap::iterator it;
-  for (it = BBTermMemo.begin(); it != BBTermMemo.end(); it++)
+  for (size_t j = 0; j < terms.size(); j++)
   {
-    const ASTNode& n = it->first;
+    const ASTNode& n = terms[j];
     assert(n.GetType() == BITVECTOR_TYPE);
 
     if (n.isConstant())
       continue;
 
-    vector<BBNode>& x = it->second;
-    assert(x.size() == n.GetValueWidth());
+    const size_t offset = BBTermMemo.find(n)->second;
+    const BBNodeVec x(BBTermBits.begin() + offset,
+                      BBTermBits.begin() + offset + n.GetValueWidth());
 
     bool constNode = true;
     for (int i = 0; i < (int)x.size(); i++)
@@ -186,14 +197,13 @@ void BitBlaster<BBNode, BBNodeManagerT>::getConsts(const ASTNode& form,
   if (true) //(uf->isSet("bb-equiv", "1"))
   {
     std::unordered_map<intptr_t, ASTNode> nodeToFn;
-    typename std::map<ASTNode, BBNode>::iterator it;
-    for (it = BBFormMemo.begin(); it != BBFormMemo.end(); it++)
+    for (size_t j = 0; j < forms.size(); j++)
     {
-      const ASTNode& n = it->first;
+      const ASTNode& n = forms[j];
       if (n.isConstant())
         continue;
 
-      const BBNode& x = it->second;
+      const BBNode& x = BBFormMemo.find(n)->second;
       if (x == BBTrue || x == BBFalse)
         continue;
 
@@ -224,14 +234,15 @@ void BitBlaster<BBNode, BBNodeManagerT>::getConsts(const ASTNode& form,
     typedef std::unordered_map<
       vector<BBNode>, ASTNode, BBVecHasher<BBNode>, BBVecEquals<BBNode>> M;
     M lookup;
-    typename std::map<ASTNode, vector<BBNode>>::iterator it;
-    for (it = BBTermMemo.begin(); it != BBTermMemo.end(); it++)
+    for (size_t j = 0; j < terms.size(); j++)
     {
-      const ASTNode& n = it->first;
+      const ASTNode& n = terms[j];
       if (n.isConstant())
         continue;
 
-      const vector<BBNode>& x = it->second;
+      const size_t offset = BBTermMemo.find(n)->second;
+      const BBNodeVec x(BBTermBits.begin() + offset,
+                        BBTermBits.begin() + offset + n.GetValueWidth());
 
       bool constNode = true;
       for (int i = 0; i < (int)x.size(); i++)
@@ -490,10 +501,10 @@ ASTNode BitBlaster<BBNode, BBNodeManagerT>::getConstant(const BBNodeVec& v,
 // simplification.
 // Then the term that we bitblast will by "y".
 template <class BBNode, class BBNodeManagerT>
-typename std::map<ASTNode, vector<BBNode>>::iterator
-BitBlaster<BBNode, BBNodeManagerT>::simplify_during_bb(
+bool BitBlaster<BBNode, BBNodeManagerT>::simplify_during_bb(
   ASTNode& term
   , BBNodeSet& support
+  , BBNodeVec& result
 ) {
   const int numberOfChildren = term.Degree();
   vector<BBNodeVec> ch;
@@ -607,42 +618,68 @@ BitBlaster<BBNode, BBNodeManagerT>::simplify_during_bb(
     term = n_term;
 
     // check if we've already done the simplified one.
-    auto it = BBTermMemo.find(term);
-    if (it != BBTermMemo.end())
-    {
-      // Constant bit propagation may have updated something.
-      updateTerm(term, it->second, support);
-      return it;
-    }
+    if (lookupTerm(term, result, support))
+      return true;
   }
 
-  return BBTermMemo.end();
+  return false;
 }
 
 template <class BBNode, class BBNodeManagerT>
-const BBNodeVec BitBlaster<BBNode, BBNodeManagerT>::BBTerm(const ASTNode& _term,
-                                                           BBNodeSet& support)
+bool BitBlaster<BBNode, BBNodeManagerT>::lookupTerm(const ASTNode& term,
+                                                    BBNodeVec& result,
+                                                    BBNodeSet& support)
 {
-  ASTNode term = _term; // mutable local copy.
+  auto it = BBTermMemo.find(term);
+  if (it == BBTermMemo.end())
+    return false;
+
+  const size_t offset = it->second;
+  result.assign(BBTermBits.begin() + offset,
+                BBTermBits.begin() + offset + term.GetValueWidth());
+
+  // Constant bit propagation may have updated something.
+  updateTerm(term, result, support);
+  std::copy(result.begin(), result.end(), BBTermBits.begin() + offset);
+  return true;
+}
+
+template <class BBNode, class BBNodeManagerT>
+void BitBlaster<BBNode, BBNodeManagerT>::storeTerm(const ASTNode& term,
+                                                   const BBNodeVec& bits)
+{
+  assert(bits.size() == term.GetValueWidth());
 
   auto it = BBTermMemo.find(term);
   if (it != BBTermMemo.end())
   {
-    // Constant bit propagation may have updated something.
-    updateTerm(term, it->second, support);
-    return it->second;
+    std::copy(bits.begin(), bits.end(), BBTermBits.begin() + it->second);
+    return;
   }
 
+  BBTermMemo.insert(std::make_pair(term, BBTermBits.size()));
+  BBTermBits.insert(BBTermBits.end(), bits.begin(), bits.end());
+}
+
+template <class BBNode, class BBNodeManagerT>
+const BBNodeVec BitBlaster<BBNode, BBNodeManagerT>::BBTerm(const ASTNode& _term,
+                                                           BBNodeSet& support)
+{
+  ASTNode term = _term; // mutable local copy.
+
+  BBNodeVec result;
+  if (lookupTerm(term, result, support))
+    return result;
+
+  if (deadline != NULL)
+    deadline->check();
+
   if (uf != NULL && uf->optimize_flag && uf->simplify_during_BB_flag)
   {
-    auto it = simplify_during_bb(term, support);
-    if (it != BBTermMemo.end()) {
-      return it->second;
-    }
+    if (simplify_during_bb(term, support, result))
+      return result;
   }
 
-  BBNodeVec result;
-
   const Kind k = term.GetKind();
   if (!is_Term_kind(k))
     FatalError("BBTerm: Illegal kind to BBTerm", term);
@@ -1024,7 +1061,8 @@ const BBNodeVec BitBlaster<BBNode, BBNodeManagerT>::BBTerm(const ASTNode& _term,
     check(result, term);
 
   updateTerm(term, result, support);
-  return (BBTermMemo[term] = result);
+  storeTerm(term, result);
+  return result;
 }
 
 template <class BBNode, class BBNodeManagerT>
@@ -1070,13 +1108,16 @@ template <class BBNode, class BBNodeManagerT>
 const BBNode BitBlaster<BBNode, BBNodeManagerT>::BBForm(const ASTNode& form,
                                                         BBNodeSet& support)
 {
-  typename std::map<ASTNode, BBNode>::iterator it = BBFormMemo.find(form);
+  auto it = BBFormMemo.find(form);
   if (it != BBFormMemo.end())
   {
     // already there.  Just return it.
     return it->second;
   }
 
+  if (deadline != NULL)
+    deadline->check();
+
   const Kind k = form.GetKind();
   if (!is_Form_kind(k))
   {
@@ -2970,7 +3011,6 @@ template class BitBlaster<ASTNode, BBNodeManagerASTNode>;
 template class BitBlaster<BBNodeAIG, BBNodeManagerAIG>;
 
 #undef BBNodeVec
-#undef BBNodeVecMap
 #undef BBNodeSet
 
 } // stp namespace
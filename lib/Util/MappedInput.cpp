@@ -0,0 +1,163 @@
+/********************************************************************
+ * AUTHORS: STP contributors
+ *
+ * BEGIN DATE: October, 2026
+ *
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+
+#include "stp/Util/MappedInput.h"
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace stp
+{
+
+MappedInput::MappedInput() : data(NULL), length(0), mapped_length(0)
+{
+}
+
+MappedInput::~MappedInput()
+{
+  close();
+}
+
+void MappedInput::close()
+{
+#if !defined(_MSC_VER)
+  if (mapped_length != 0)
+    munmap(data, mapped_length);
+#endif
+  data = NULL;
+  length = 0;
+  mapped_length = 0;
+  std::vector<char>().swap(copy);
+}
+
+#if !defined(_MSC_VER)
+
+bool MappedInput::open(const char* path)
+{
+  close();
+
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  bool ok = false;
+  if (fstat(fd, &st) == 0)
+  {
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+      ok = map(fd, (size_t)st.st_size) || readAll(fd);
+    else
+      ok = readAll(fd);
+  }
+  ::close(fd);
+  return ok;
+}
+
+bool MappedInput::map(int fd, size_t size)
+{
+  // Reserve room for the text and the two NULs, then map the file over
+  // the start of it. Whatever follows the end of the file, in the rest
+  // of its last page or in the anonymous pages after that, reads as zero.
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  const size_t total = (size + 2 + page - 1) / page * page;
+
+  void* region = mmap(NULL, total, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED)
+    return false;
+
+  if (mmap(region, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+           0) == MAP_FAILED)
+  {
+    munmap(region, total);
+    return false;
+  }
+
+#ifdef MADV_SEQUENTIAL
+  madvise(region, total, MADV_SEQUENTIAL);
+#endif
+
+  data = (char*)region;
+  length = size;
+  mapped_length = total;
+  return true;
+}
+
+bool MappedInput::readAll(int fd)
+{
+  size_t used = 0;
+  copy.resize(1 << 16);
+  while (true)
+  {
+    if (used == copy.size())
+      copy.resize(copy.size() * 2);
+
+    const ssize_t got = ::read(fd, &copy[used], copy.size() - used);
+    if (got < 0)
+    {
+      std::vector<char>().swap(copy);
+      return false;
+    }
+    if (got == 0)
+      break;
+    used += (size_t)got;
+  }
+
+  copy.resize(used + 2);
+  copy[used] = copy[used + 1] = '\0';
+  data = &copy[0];
+  length = used;
+  return true;
+}
+
+#else
+
+bool MappedInput::open(const char* path)
+{
+  close();
+
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in)
+    return false;
+
+  copy.assign(std::istreambuf_iterator<char>(in),
+              std::istreambuf_iterator<char>());
+  length = copy.size();
+  copy.push_back('\0');
+  copy.push_back('\0');
+  data = &copy[0];
+  return true;
+}
+
+#endif
+
+} // end namespace stp
@@ -51,7 +51,12 @@ std::string RunTimes::CategoryNames[] = {
     "Array Read Refinement",  "Applying Substitutions",
     "Removing Unconstrained", "Pure Literals",
     "ITE Contexts",           "AIG core simplification",
-    "Interval Propagation",   "Always True"};
+    "Interval Propagation",   "Always True",
+    "Query Cache Hits",       "Query Cache Misses",
+    "Model Reuse Hits",       "Model Reuse Misses",
+    "Unsat Core Hits",        "Unsat Core Misses",
+    "Query Cache File Hits",  "AIG Sweep Merges",
+    "AIG Rewrite Steps",      "AIG Rewrite Nodes Removed"};
 
 namespace stp
 {
@@ -88,7 +93,8 @@ void RunTimes::print()
     if ((it2 = times.find(it1->first)) != times.end())
       time_ms = it2->second;
 
-    if (time_ms != 0)
+    // Some categories are only counted, never timed.
+    if (time_ms != 0 || it2 == times.end())
     {
       result << " " << CategoryNames[it1->first] << ": " << it1->second;
       result << " [" << time_ms << "ms]";
@@ -151,6 +157,17 @@ void RunTimes::addCount(Category c)
   }
 }
 
+void RunTimes::addCount(Category c, int n)
+{
+  counts[c] += n;
+}
+
+int RunTimes::getCount(Category c) const
+{
+  std::map<Category, int>::const_iterator it = counts.find(c);
+  return (it == counts.end()) ? 0 : it->second;
+}
+
 void RunTimes::stop(Category c)
 {
   Element e = category_stack.top();
@@ -165,6 +182,12 @@ void RunTimes::stop(Category c)
   addCount(c);
 }
 
+void RunTimes::unwind(size_t depth)
+{
+  while (category_stack.size() > depth)
+    stop(category_stack.top().first);
+}
+
 void RunTimes::start(Category c)
 {
   category_stack.push(std::make_pair(c, getCurrentTime()));
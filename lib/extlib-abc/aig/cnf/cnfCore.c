@@ -42,7 +42,7 @@ SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Cnf_Man_t * s_pManCnf = NULL;
+static ABC_THREAD_LOCAL Cnf_Man_t * s_pManCnf = NULL;
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -59,7 +59,7 @@ static Cnf_Man_t * s_pManCnf = NULL;
   SeeAlso     []
 
 ***********************************************************************/
-Cnf_Dat_t * Cnf_Derive( Aig_Man_t * pAig, int nOutputs )
+static Cnf_Dat_t * Cnf_DeriveInt( Aig_Man_t * pAig, int nOutputs, Cnf_Sink_t * pSink )
 {
     Cnf_Man_t * p;
     Cnf_Dat_t * pCnf;
@@ -88,7 +88,10 @@ p->timeMap = clock() - clk;
 clk = clock();
     Cnf_ManTransferCuts( p );
     vMapped = Cnf_ManScanMapping( p, 1, 1 );
-    pCnf = Cnf_ManWriteCnf( p, vMapped, nOutputs );
+    if ( pSink )
+        pCnf = Cnf_ManWriteCnfToSink( p, vMapped, nOutputs, pSink );
+    else
+        pCnf = Cnf_ManWriteCnf( p, vMapped, nOutputs );
     Vec_PtrFree( vMapped );
     Aig_MmFixedStop( pMemCuts, 0 );
 p->timeSave = clock() - clk;
@@ -101,6 +104,29 @@ p->timeSave = clock() - clk;
     return pCnf;
 }
 
+Cnf_Dat_t * Cnf_Derive( Aig_Man_t * pAig, int nOutputs )
+{
+    return Cnf_DeriveInt( pAig, nOutputs, NULL );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Converts AIG into the SAT solver, one clause at a time.]
+
+  Description [As Cnf_Derive, but the clauses are passed to the sink
+  as they are written rather than stored. The returned CNF holds the
+  variable numbers only.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cnf_Dat_t * Cnf_DeriveToSink( Aig_Man_t * pAig, int nOutputs, Cnf_Sink_t * pSink )
+{
+    return Cnf_DeriveInt( pAig, nOutputs, pSink );
+}
+
 /**Function*************************************************************
 
   Synopsis    []
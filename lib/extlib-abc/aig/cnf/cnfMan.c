@@ -140,8 +140,12 @@ void Cnf_DataFree( Cnf_Dat_t * p )
 {
     if ( p == NULL )
         return;
-    free( p->pClauses[0] );
-    free( p->pClauses );
+    // a CNF derived into a sink has no clauses
+    if ( p->pClauses )
+    {
+        free( p->pClauses[0] );
+        free( p->pClauses );
+    }
     free( p->pVarNums );
     free( p );
 }
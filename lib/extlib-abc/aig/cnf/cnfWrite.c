@@ -161,75 +161,92 @@ int Cnf_IsopWriteCube( int Cube, int nVars, int * pVars, int * pLiterals )
     return nLits;
 }
 
+// Either records where the next clause starts in the CNF, or, when the
+// clauses go to a sink, starts again at the beginning of the buffer.
+#define Cnf_ClauseBegin()                                               \
+    if ( pSink ) pLits = pBuffer; else *pClas++ = pLits;
+// Hands a finished clause to the sink.
+#define Cnf_ClauseEnd()                                                 \
+    if ( pSink ) { nClauses++; nLiterals += pLits - pBuffer;            \
+                   pSink->pfAddClause( pSink->pData, pBuffer, pLits - pBuffer ); }
+
 /**Function*************************************************************
 
   Synopsis    [Derives CNF for the mapping.]
 
   Description [The last argument shows the number of last outputs
   of the manager, which will not be converted into clauses but the
-  new variables for which will be introduced.]
+  new variables for which will be introduced. If pSink is given, the
+  clauses are passed to it one at a time and never stored, so the
+  returned CNF has the variable numbers but no clauses.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
+static Cnf_Dat_t * Cnf_ManWriteCnfInt( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs, Cnf_Sink_t * pSink )
 {
     Aig_Obj_t * pObj;
     Cnf_Dat_t * pCnf;
     Cnf_Cut_t * pCut;
     Vec_Int_t * vCover, * vSopTemp;
     int OutVar, PoVar, pVars[32], * pLits, ** pClas;
+    int pBuffer[34]; // the output literal and at most 32 fanins
     unsigned uTruth;
     int i, k, nLiterals, nClauses, Cube, Number;
 
-    // count the number of literals and clauses
-    nLiterals = 1 + Aig_ManPoNum( p->pManAig ) + 3 * nOutputs;
-    nClauses = 1 + Aig_ManPoNum( p->pManAig ) + nOutputs;
-    Vec_PtrForEachEntry( vMapped, pObj, i )
-    {
-        assert( Aig_ObjIsNode(pObj) );
-        pCut = Cnf_ObjBestCut( pObj );
+    // allocate CNF
+    pCnf = ALLOC( Cnf_Dat_t, 1 );
+    memset( pCnf, 0, sizeof(Cnf_Dat_t) );
+    nLiterals = nClauses = 0;
+    pClas = NULL;
+    pLits = NULL;
 
-        // positive polarity of the cut
-        if ( pCut->nFanins < 5 )
-        {
-            uTruth = 0xFFFF & *Cnf_CutTruth(pCut);
-            nLiterals += Cnf_SopCountLiterals( p->pSops[uTruth], p->pSopSizes[uTruth] ) + p->pSopSizes[uTruth];
-            assert( p->pSopSizes[uTruth] >= 0 );
-            nClauses += p->pSopSizes[uTruth];
-        }
-        else
-        {
-            nLiterals += Cnf_IsopCountLiterals( pCut->vIsop[1], pCut->nFanins ) + Vec_IntSize(pCut->vIsop[1]);
-            nClauses += Vec_IntSize(pCut->vIsop[1]);
-        }
-        // negative polarity of the cut
-        if ( pCut->nFanins < 5 )
-        {
-            uTruth = 0xFFFF & ~*Cnf_CutTruth(pCut);
-            nLiterals += Cnf_SopCountLiterals( p->pSops[uTruth], p->pSopSizes[uTruth] ) + p->pSopSizes[uTruth];
-            assert( p->pSopSizes[uTruth] >= 0 );
-            nClauses += p->pSopSizes[uTruth];
-        }
-        else
+    if ( pSink == NULL )
+    {
+        // count the number of literals and clauses
+        nLiterals = 1 + Aig_ManPoNum( p->pManAig ) + 3 * nOutputs;
+        nClauses = 1 + Aig_ManPoNum( p->pManAig ) + nOutputs;
+        Vec_PtrForEachEntry( vMapped, pObj, i )
         {
-            nLiterals += Cnf_IsopCountLiterals( pCut->vIsop[0], pCut->nFanins ) + Vec_IntSize(pCut->vIsop[0]);
-            nClauses += Vec_IntSize(pCut->vIsop[0]);
+            assert( Aig_ObjIsNode(pObj) );
+            pCut = Cnf_ObjBestCut( pObj );
+
+            // positive polarity of the cut
+            if ( pCut->nFanins < 5 )
+            {
+                uTruth = 0xFFFF & *Cnf_CutTruth(pCut);
+                nLiterals += Cnf_SopCountLiterals( p->pSops[uTruth], p->pSopSizes[uTruth] ) + p->pSopSizes[uTruth];
+                assert( p->pSopSizes[uTruth] >= 0 );
+                nClauses += p->pSopSizes[uTruth];
+            }
+            else
+            {
+                nLiterals += Cnf_IsopCountLiterals( pCut->vIsop[1], pCut->nFanins ) + Vec_IntSize(pCut->vIsop[1]);
+                nClauses += Vec_IntSize(pCut->vIsop[1]);
+            }
+            // negative polarity of the cut
+            if ( pCut->nFanins < 5 )
+            {
+                uTruth = 0xFFFF & ~*Cnf_CutTruth(pCut);
+                nLiterals += Cnf_SopCountLiterals( p->pSops[uTruth], p->pSopSizes[uTruth] ) + p->pSopSizes[uTruth];
+                assert( p->pSopSizes[uTruth] >= 0 );
+                nClauses += p->pSopSizes[uTruth];
+            }
+            else
+            {
+                nLiterals += Cnf_IsopCountLiterals( pCut->vIsop[0], pCut->nFanins ) + Vec_IntSize(pCut->vIsop[0]);
+                nClauses += Vec_IntSize(pCut->vIsop[0]);
+            }
         }
-//printf( "%d ", nClauses-(1 + Aig_ManPoNum( p->pManAig )) );
-    }
-//printf( "\n" );
 
-    // allocate CNF
-    pCnf = ALLOC( Cnf_Dat_t, 1 );
-    memset( pCnf, 0, sizeof(Cnf_Dat_t) );
-    pCnf->nLiterals = nLiterals;
-    pCnf->nClauses = nClauses;
-    pCnf->pClauses = ALLOC( int *, nClauses + 1 );
-    pCnf->pClauses[0] = ALLOC( int, nLiterals );
-    pCnf->pClauses[nClauses] = pCnf->pClauses[0] + nLiterals;
+        pCnf->pClauses = ALLOC( int *, nClauses + 1 );
+        pCnf->pClauses[0] = ALLOC( int, nLiterals );
+        pCnf->pClauses[nClauses] = pCnf->pClauses[0] + nLiterals;
+        pLits = pCnf->pClauses[0];
+        pClas = pCnf->pClauses;
+    }
 
     // create room for variable numbers
     pCnf->pVarNums = ALLOC( int, Aig_ManObjNumMax(p->pManAig) );
@@ -250,11 +267,11 @@ Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
         pCnf->pVarNums[pObj->Id] = Number++;
     pCnf->pVarNums[Aig_ManConst1(p->pManAig)->Id] = Number++;
     pCnf->nVars = Number;
+    if ( pSink )
+        pSink->pfNewVars( pSink->pData, Number );
 
     // assign the clauses
     vSopTemp = Vec_IntAlloc( 1 << 16 );
-    pLits = pCnf->pClauses[0];
-    pClas = pCnf->pClauses;
     Vec_PtrForEachEntry( vMapped, pObj, i )
     {
         pCut = Cnf_ObjBestCut( pObj );
@@ -278,9 +295,10 @@ Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
             vCover = pCut->vIsop[1];
         Vec_IntForEachEntry( vCover, Cube, k )
         {
-            *pClas++ = pLits;
+            Cnf_ClauseBegin();
             *pLits++ = 2 * OutVar; 
             pLits += Cnf_IsopWriteCube( Cube, pCut->nFanins, pVars, pLits );
+            Cnf_ClauseEnd();
         }
 
         // negative polarity of the cut
@@ -294,9 +312,10 @@ Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
             vCover = pCut->vIsop[0];
         Vec_IntForEachEntry( vCover, Cube, k )
         {
-            *pClas++ = pLits;
+            Cnf_ClauseBegin();
             *pLits++ = 2 * OutVar + 1; 
             pLits += Cnf_IsopWriteCube( Cube, pCut->nFanins, pVars, pLits );
+            Cnf_ClauseEnd();
         }
     }
     Vec_IntFree( vSopTemp );
@@ -304,8 +323,9 @@ Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
     // write the constant literal
     OutVar = pCnf->pVarNums[ Aig_ManConst1(p->pManAig)->Id ];
     assert( OutVar <= Aig_ManObjNumMax(p->pManAig) );
-    *pClas++ = pLits;
+    Cnf_ClauseBegin();
     *pLits++ = 2 * OutVar; 
+    Cnf_ClauseEnd();
 
     // write the output literals
     Aig_ManForEachPo( p->pManAig, pObj, i )
@@ -313,29 +333,48 @@ Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
         OutVar = pCnf->pVarNums[ Aig_ObjFanin0(pObj)->Id ];
         if ( i < Aig_ManPoNum(p->pManAig) - nOutputs )
         {
-            *pClas++ = pLits;
+            Cnf_ClauseBegin();
             *pLits++ = 2 * OutVar + Aig_ObjFaninC0(pObj); 
+            Cnf_ClauseEnd();
         }
         else
         {
             PoVar = pCnf->pVarNums[ pObj->Id ];
             // first clause
-            *pClas++ = pLits;
+            Cnf_ClauseBegin();
             *pLits++ = 2 * PoVar; 
             *pLits++ = 2 * OutVar + !Aig_ObjFaninC0(pObj); 
+            Cnf_ClauseEnd();
             // second clause
-            *pClas++ = pLits;
+            Cnf_ClauseBegin();
             *pLits++ = 2 * PoVar + 1; 
             *pLits++ = 2 * OutVar + Aig_ObjFaninC0(pObj); 
+            Cnf_ClauseEnd();
         }
     }
 
+    pCnf->nLiterals = nLiterals;
+    pCnf->nClauses = nClauses;
+    if ( pSink )
+        return pCnf;
+
     // verify that the correct number of literals and clauses was written
     assert( pLits - pCnf->pClauses[0] == nLiterals );
     assert( pClas - pCnf->pClauses == nClauses );
     return pCnf;
 }
 
+Cnf_Dat_t * Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs )
+{
+    return Cnf_ManWriteCnfInt( p, vMapped, nOutputs, NULL );
+}
+
+Cnf_Dat_t * Cnf_ManWriteCnfToSink( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs, Cnf_Sink_t * pSink )
+{
+    assert( pSink != NULL );
+    return Cnf_ManWriteCnfInt( p, vMapped, nOutputs, pSink );
+}
+
 // Create a new partial CNF with just the extra bits versus the old CNF.
 // This uses the Tseitin transform of Cnf_DeriveSimple
 // NB. We assume there will only be one more PO than last time.
@@ -119,6 +119,9 @@ int Dar_ManRewrite( Aig_Man_t * pAig, Dar_RwrPar_t * pPars )
             continue;
         if ( i > nNodesOld )
             break;
+        // check for a stop request every so often
+        if ( p->pPars->pfStop && (i & 0xFF) == 0 && p->pPars->pfStop( p->pPars->pStopData ) )
+            break;
 
         // consider freeing the cuts
 //        if ( (i & 0xFFF) == 0 && Aig_MmFixedReadMemUsage(p->pMemCuts)/(1<<20) > 100 )
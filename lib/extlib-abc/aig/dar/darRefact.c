@@ -358,7 +358,6 @@ printf( "\n" );
   SeeAlso     []
 
 ***********************************************************************/
-#if 0
 int Dar_ManRefactorTryCuts( Ref_Man_t * p, Aig_Obj_t * pObj, int nNodesSaved, int Required )
 {
     Vec_Ptr_t * vCut;
@@ -382,14 +381,16 @@ int Dar_ManRefactorTryCuts( Ref_Man_t * p, Aig_Obj_t * pObj, int nNodesSaved, in
         pTruth = Aig_ManCutTruth( pObj, vCut, p->vCutNodes, p->vTruthElem, p->vTruthStore );
         if ( Kit_TruthIsConst0(pTruth, Vec_PtrSize(vCut)) )
         {
-            p->GainBest = Vec_PtrSize(p->vCutNodes);
+            // only the MFFC goes, the other nodes of the cut may be shared
+            p->GainBest = nNodesSaved;
             p->pGraphBest = Kit_GraphCreateConst0();
             Vec_PtrCopy( p->vLeavesBest, vCut );
             return p->GainBest;
         }
         if ( Kit_TruthIsConst1(pTruth, Vec_PtrSize(vCut)) )
         {
-            p->GainBest = Vec_PtrSize(p->vCutNodes);
+            // only the MFFC goes, the other nodes of the cut may be shared
+            p->GainBest = nNodesSaved;
             p->pGraphBest = Kit_GraphCreateConst1();
             Vec_PtrCopy( p->vLeavesBest, vCut );
             return p->GainBest;
@@ -447,7 +448,6 @@ int Dar_ManRefactorTryCuts( Ref_Man_t * p, Aig_Obj_t * pObj, int nNodesSaved, in
     }
     return p->GainBest;
 }
-#endif
 
 /**Function*************************************************************
 
@@ -481,7 +481,6 @@ int Dar_ObjCutLevelAchieved( Vec_Ptr_t * vCut, int nLevelMin )
   SeeAlso     []
  
 ***********************************************************************/
-#if 0
 int Dar_ManRefactor( Aig_Man_t * pAig, Dar_RefPar_t * pPars )
 {
 //    Bar_Progress_t * pProgress;
@@ -514,6 +513,9 @@ int Dar_ManRefactor( Aig_Man_t * pAig, Dar_RefPar_t * pPars )
             continue;
         if ( i > nNodesOld )
             break;
+        // check for a stop request every so often
+        if ( p->pPars->pfStop && (i & 0xFF) == 0 && p->pPars->pfStop( p->pPars->pStopData ) )
+            break;
         Vec_VecClear( p->vCuts );
 
 //printf( "\nConsidering node %d.\n", pObj->Id );
@@ -604,7 +606,6 @@ p->timeOther = p->timeTotal - p->timeCuts - p->timeEval;
     return 1;
 
 }
-#endif
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
@@ -984,7 +984,7 @@ void Kit_TruthMuxVarPhase( unsigned * pOut, unsigned * pCof0, unsigned * pCof1,
 ***********************************************************************/
 int Kit_TruthVarsSymm( unsigned * pTruth, int nVars, int iVar0, int iVar1 )
 {
-    static unsigned uTemp0[16], uTemp1[16];
+    static ABC_THREAD_LOCAL unsigned uTemp0[16], uTemp1[16];
     assert( nVars <= 9 );
     // compute Cof01
     Kit_TruthCopy( uTemp0, pTruth, nVars );
@@ -1011,7 +1011,7 @@ int Kit_TruthVarsSymm( unsigned * pTruth, int nVars, int iVar0, int iVar1 )
 ***********************************************************************/
 int Kit_TruthVarsAntiSymm( unsigned * pTruth, int nVars, int iVar0, int iVar1 )
 {
-    static unsigned uTemp0[16], uTemp1[16];
+    static ABC_THREAD_LOCAL unsigned uTemp0[16], uTemp1[16];
     assert( nVars <= 9 );
     // compute Cof00
     Kit_TruthCopy( uTemp0, pTruth, nVars );
@@ -1094,7 +1094,7 @@ void Kit_TruthChangePhase( unsigned * pTruth, int nVars, int iVar )
 ***********************************************************************/
 int Kit_TruthMinCofSuppOverlap( unsigned * pTruth, int nVars, int * pVarMin )
 {
-    static unsigned uCofactor[16];
+    static ABC_THREAD_LOCAL unsigned uCofactor[16];
     int i, ValueCur, ValueMin, VarMin;
     unsigned uSupp0, uSupp1;
     int nVars0, nVars1;
@@ -1720,7 +1720,7 @@ void Kit_TruthCountMintermsPrecomp()
 ***********************************************************************/
 char * Kit_TruthDumpToFile( unsigned * pTruth, int nVars, int nFile )
 {
-    static char pFileName[100];
+    static ABC_THREAD_LOCAL char pFileName[100];
     FILE * pFile;
     sprintf( pFileName, "tt\\s%04d", nFile );
     pFile = fopen( pFileName, "w" );
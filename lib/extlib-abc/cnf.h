@@ -68,6 +68,7 @@ extern "C" {
 typedef struct Cnf_Man_t_            Cnf_Man_t;
 typedef struct Cnf_Dat_t_            Cnf_Dat_t;
 typedef struct Cnf_Cut_t_            Cnf_Cut_t;
+typedef struct Cnf_Sink_t_           Cnf_Sink_t;
 
 // the CNF asserting outputs of AIG to be 1
 struct Cnf_Dat_t_
@@ -80,6 +81,14 @@ struct Cnf_Dat_t_
     int *           pVarNums;        // the number of CNF variable for each node ID (-1 if unused)
 };
 
+// receives the clauses one at a time as they are derived (an STP addition)
+struct Cnf_Sink_t_
+{
+    void *          pData;           // passed back to the callbacks
+    void (*pfNewVars)( void * pData, int nVars );                 // called once, before any clause
+    void (*pfAddClause)( void * pData, int * pLits, int nLits );  // literals as in pClauses
+};
+
 // the cut used to represent node in the AIG
 struct Cnf_Cut_t_
 {
@@ -136,6 +145,7 @@ static inline void         Cnf_ObjSetBestCut( Aig_Obj_t * pObj, Cnf_Cut_t * pCut
 
 /*=== cnfCore.c ========================================================*/
 extern Cnf_Dat_t *     Cnf_Derive( Aig_Man_t * pAig, int nOutputs );
+extern Cnf_Dat_t *     Cnf_DeriveToSink( Aig_Man_t * pAig, int nOutputs, Cnf_Sink_t * pSink );
 extern Cnf_Man_t *     Cnf_ManRead();
 extern void            Cnf_ClearMemory();
 /*=== cnfCut.c ========================================================*/
@@ -166,6 +176,7 @@ extern Vec_Ptr_t *     Cnf_ManScanMapping( Cnf_Man_t * p, int fCollect, int fPre
 /*=== cnfWrite.c ========================================================*/
 extern void            Cnf_SopConvertToVector( char * pSop, int nCubes, Vec_Int_t * vCover );
 extern Cnf_Dat_t *     Cnf_ManWriteCnf( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs );
+extern Cnf_Dat_t *     Cnf_ManWriteCnfToSink( Cnf_Man_t * p, Vec_Ptr_t * vMapped, int nOutputs, Cnf_Sink_t * pSink );
 extern Cnf_Dat_t *     Cnf_DeriveSimple( Aig_Man_t * p, int nOutputs );
 
 #ifdef __cplusplus
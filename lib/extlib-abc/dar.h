@@ -67,6 +67,8 @@ struct Dar_RwrPar_t_
     int              fUseZeros;      // performs zero-cost replacement
     int              fVerbose;       // enables verbose output
     int              fVeryVerbose;   // enables very verbose output
+    int           (* pfStop)( void * ); // stops rewriting early if it returns 1
+    void *           pStopData;      // passed to pfStop
 };
 
 struct Dar_RefPar_t_  
@@ -79,6 +81,8 @@ struct Dar_RefPar_t_
     int              fUseZeros;      // perform zero-cost replacements
     int              fVerbose;       // verbosity level
     int              fVeryVerbose;   // enables very verbose output
+    int           (* pfStop)( void * ); // stops refactoring early if it returns 1
+    void *           pStopData;      // passed to pfStop
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -63,6 +63,16 @@ extern "C" {
 ///                      MACRO DEFINITIONS                           ///
 ////////////////////////////////////////////////////////////////////////
 
+// storage class for the package's mutable statics, so that
+// independent STP instances can run on different threads
+#ifndef ABC_THREAD_LOCAL
+#if defined(_MSC_VER)
+#define ABC_THREAD_LOCAL __declspec(thread)
+#else
+#define ABC_THREAD_LOCAL __thread
+#endif
+#endif
+
 #ifndef ABS
 #define ABS(a)			((a) < 0 ? -(a) : (a))
 #endif
@@ -269,7 +269,7 @@ namespace CONSTANTBV {
   /*                                                     */
   /*******************************************************/
 
-  ErrCode BitVector_Boot(void) {
+  static ErrCode BitVector_Boot_Once(void) {
     unsigned long longsample = 1L;
     unsigned int sample = LSB;
     unsigned int lsb;
@@ -314,6 +314,13 @@ namespace CONSTANTBV {
     return(ErrCode_Ok);
   }
 
+  /* Every STP instance calls this, possibly from several threads at once,  */
+  /* so the constants are computed exactly once (thread-safe local static). */
+  ErrCode BitVector_Boot(void) {
+    static const ErrCode result = BitVector_Boot_Once();
+    return(result);
+  }
+
   unsigned int BitVector_Size(unsigned int bits) {          /* bit vector size (# of words)  */
     unsigned int size;
 
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2026 STP contributors
+
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+
+# Writes one query over a chain of wide multiplications, which bit-blasts
+# to millions of clauses, then reports the peak RSS and run time of stp on
+# it with the CNF added to the SAT solver as ABC derives it (the default),
+# and with the whole CNF built first (--disable-cnf-streaming).
+
+from __future__ import print_function
+import optparse
+import os
+import random
+import subprocess
+import time
+
+
+def write_query(f, rnd, width, length):
+    f.write("(set-logic QF_BV)\n")
+    for i in range(length + 1):
+        f.write("(declare-fun x%d () (_ BitVec %d))\n" % (i, width))
+    term = "x0"
+    for i in range(1, length + 1):
+        f.write("(assert (not (= x%d (_ bv0 %d))))\n" % (i, width))
+        term = "(bvadd (bvmul %s x%d) (_ bv%d %d))" % (
+            term, i, rnd.getrandbits(width), width)
+    f.write("(assert (= %s (_ bv%d %d)))\n" % (term, rnd.getrandbits(width), width))
+    f.write("(check-sat)\n(exit)\n")
+
+
+def run(stp, args, path):
+    start = time.time()
+    with open(os.devnull, "w") as null:
+        p = subprocess.Popen([stp] + args + [path], stdout=null)
+        _, status, usage = os.wait4(p.pid, 0)
+    # ru_maxrss is in kilobytes on Linux.
+    return status, usage.ru_maxrss / 1024.0, time.time() - start
+
+
+def main():
+    parser = optparse.OptionParser(usage="usage: %prog [options]")
+    parser.add_option("--stp", default="stp", help="stp binary to run")
+    parser.add_option("--width", type=int, default=64,
+                      help="width of the multiplications")
+    parser.add_option("--length", type=int, default=200,
+                      help="number of multiplications in the chain")
+    parser.add_option("--file", default="cnf-stream-benchmark.smt2",
+                      help="where to write the benchmark")
+    parser.add_option("--seed", type=int, default=1)
+    (options, _) = parser.parse_args()
+
+    rnd = random.Random(options.seed)
+    with open(options.file, "w") as f:
+        write_query(f, rnd, options.width, options.length)
+
+    for args in (["--disable-cnf-streaming"], []):
+        status, rss, seconds = run(options.stp, args, options.file)
+        print("%-26s exit %d  peak RSS %.1f MB  %.1f s" %
+              (" ".join(args) or "default", status >> 8, rss, seconds))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2026 STP contributors
+
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+
+# Compares how fast stp parses the larger CVC and SMT-LIB1 files under
+# tests/query-files when it maps them (the file is given on the command
+# line) and when it reads them through stdio (the file is fed on stdin).
+# The time is the "Parsing" line of stp -t. SMT-LIB2 files are left out
+# because that parser runs the commands as it reads them, so its parse
+# time includes the solving.
+
+from __future__ import print_function
+import optparse
+import os
+import re
+import subprocess
+
+LANGUAGES = {".cvc": "--CVC", ".smt": "-m"}
+PARSING = re.compile(r"^ Parsing: \d+ \[(\d+)ms\]", re.M)
+
+
+def parse_ms(stp, lang, path, stdin, max_time):
+    args = [stp, "-t", lang, "--max-time", str(max_time)]
+    with open(path, "rb") as f, open(os.devnull, "w") as null:
+        if stdin:
+            p = subprocess.Popen(args, stdin=f, stdout=null,
+                                 stderr=subprocess.PIPE)
+        else:
+            p = subprocess.Popen(args + [path], stdout=null,
+                                 stderr=subprocess.PIPE)
+        _, err = p.communicate()
+    err = err.decode("utf-8", "replace")
+    m = PARSING.search(err)
+    if m:
+        return int(m.group(1))
+    # Categories that took under a millisecond aren't printed.
+    return 0 if "statistics" in err else None
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = optparse.OptionParser(usage="usage: %prog [options]")
+    parser.add_option("--stp", default="stp", help="stp binary to run")
+    parser.add_option("--dir",
+                      default=os.path.join(here, "..", "..", "tests",
+                                           "query-files"),
+                      help="directory to search for inputs")
+    parser.add_option("--min-kb", type=int, default=32,
+                      help="skip inputs smaller than this")
+    parser.add_option("--repeat", type=int, default=5,
+                      help="runs per file and mode, the fastest is kept")
+    parser.add_option("--max-time", type=int, default=1000,
+                      help="milliseconds stp may spend solving each file")
+    (options, _) = parser.parse_args()
+
+    files = []
+    for root, _, names in os.walk(options.dir):
+        for name in names:
+            path = os.path.join(root, name)
+            lang = LANGUAGES.get(os.path.splitext(name)[1])
+            if lang and os.path.getsize(path) >= options.min_kb * 1024:
+                files.append((os.path.getsize(path), path, lang))
+    files.sort(reverse=True)
+
+    total_mb = 0.0
+    total_ms = {"mmap": 0, "stdio": 0}
+    for size, path, lang in files:
+        mb = size / (1024.0 * 1024.0)
+        row = {}
+        for mode in ("mmap", "stdio"):
+            times = [parse_ms(options.stp, lang, path, mode == "stdio",
+                              options.max_time)
+                     for _ in range(options.repeat)]
+            times = [t for t in times if t is not None]
+            row[mode] = min(times) if times else None
+        if None in row.values():
+            print("%s: no parse time reported, skipped" % path)
+            continue
+        total_mb += mb
+        for mode in row:
+            total_ms[mode] += row[mode]
+        print("%-60s %7.2f MB  mmap %5d ms  stdio %5d ms" %
+              (os.path.relpath(path, options.dir), mb, row["mmap"],
+               row["stdio"]))
+
+    for mode in ("mmap", "stdio"):
+        seconds = max(total_ms[mode], 1) / 1000.0
+        print("%-5s %.2f MB in %.3f s: %.1f MB/s" %
+              (mode, total_mb, seconds, total_mb / seconds))
+
+
+if __name__ == "__main__":
+    main()
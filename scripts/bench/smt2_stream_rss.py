@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2026 STP contributors
+
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+
+# Writes a long SMT-LIB2 command stream, like the ones fuzzers dump, then
+# reports the peak RSS and run time of stp on it with and without
+# --streaming.
+
+from __future__ import print_function
+import optparse
+import os
+import random
+import subprocess
+import time
+
+
+def write_query(f, i, rnd, depth):
+    f.write("(push 1)\n")
+    f.write("(declare-fun a%d () (_ BitVec 32))\n" % i)
+    f.write("(declare-fun b%d () (_ BitVec 32))\n" % i)
+    term = "a%d" % i
+    f.write("(assert ")
+    for d in range(depth):
+        f.write("(let ((?t%d (bvadd (bvmul %s #x%08x) b%d))) " %
+                (d, term, rnd.getrandbits(32) | 1, i))
+        term = "?t%d" % d
+    f.write("(= %s #x%08x)" % (term, rnd.getrandbits(32)))
+    f.write(")" * depth + ")\n")
+    f.write("(check-sat)\n")
+    f.write("(get-value (a%d b%d))\n" % (i, i))
+    f.write("(pop 1)\n")
+
+
+def run(stp, args, path):
+    start = time.time()
+    with open(os.devnull, "w") as null:
+        p = subprocess.Popen([stp] + args + [path], stdout=null)
+        _, status, usage = os.wait4(p.pid, 0)
+    # ru_maxrss is in kilobytes on Linux.
+    return status, usage.ru_maxrss / 1024.0, time.time() - start
+
+
+def main():
+    parser = optparse.OptionParser(usage="usage: %prog [options]")
+    parser.add_option("--stp", default="stp", help="stp binary to run")
+    parser.add_option("--queries", type=int, default=100000,
+                      help="number of check-sats to write")
+    parser.add_option("--depth", type=int, default=50,
+                      help="nesting of the lets in each assertion")
+    parser.add_option("--file", default="stream-benchmark.smt2",
+                      help="where to write the benchmark")
+    parser.add_option("--seed", type=int, default=1)
+    (options, _) = parser.parse_args()
+
+    rnd = random.Random(options.seed)
+    with open(options.file, "w") as f:
+        f.write("(set-logic QF_BV)\n")
+        for i in range(options.queries):
+            write_query(f, i, rnd, options.depth)
+        f.write("(exit)\n")
+    size = os.path.getsize(options.file) / (1024.0 * 1024.0)
+    print("%s: %.1f MB, %d queries" % (options.file, size, options.queries))
+
+    for args in ([], ["--streaming"]):
+        status, rss, seconds = run(options.stp, args, options.file)
+        print("%-12s exit %d  peak RSS %.1f MB  %.1f s" %
+              (" ".join(args) or "default", status >> 8, rss, seconds))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,98 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// Rewriting mustn't change the answer. The word-level simplifications
+// don't know that a + b is (a | b) + (a & b), so the two adders reach the
+// bit-blasted circuit, where rewriting finds the nodes they share.
+TEST(aig_rewrite, valid)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, AIG_REWRITE, 1);
+
+  Type bv8 = vc_bvType(vc, 8);
+  Expr a = vc_varExpr(vc, "a", bv8);
+  Expr b = vc_varExpr(vc, "b", bv8);
+
+  Expr sum = vc_bvPlusExpr(vc, 8, a, b);
+  Expr parts = vc_bvPlusExpr(vc, 8, vc_bvOrExpr(vc, a, b), vc_bvAndExpr(vc, a, b));
+  ASSERT_EQ(1, vc_query(vc, vc_eqExpr(vc, sum, parts)));
+
+  // rw, rf, b and rw.
+  ASSERT_EQ(4, vc_getStatistic(vc, AIG_REWRITE_STEPS));
+  ASSERT_GE(vc_getStatistic(vc, AIG_REWRITE_NODES_REMOVED), 1);
+
+  vc_Destroy(vc);
+}
+
+// Refactoring on its own, which needs kitFactor.c.
+TEST(aig_rewrite, refactor)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, AIG_REWRITE, 1);
+  ASSERT_EQ(0, vc_setAIGRewriteScript(vc, "rf,xx"));
+  ASSERT_EQ(1, vc_setAIGRewriteScript(vc, "rf"));
+
+  Type bv8 = vc_bvType(vc, 8);
+  Expr a = vc_varExpr(vc, "a", bv8);
+  Expr b = vc_varExpr(vc, "b", bv8);
+
+  Expr sum = vc_bvPlusExpr(vc, 8, a, b);
+  Expr parts = vc_bvPlusExpr(vc, 8, vc_bvOrExpr(vc, a, b), vc_bvAndExpr(vc, a, b));
+  ASSERT_EQ(1, vc_query(vc, vc_eqExpr(vc, sum, parts)));
+
+  ASSERT_EQ(1, vc_getStatistic(vc, AIG_REWRITE_STEPS));
+  ASSERT_GE(vc_getStatistic(vc, AIG_REWRITE_NODES_REMOVED), 1);
+
+  vc_Destroy(vc);
+}
+
+// The model is checked against the input, so it has to survive the
+// rewriting too.
+TEST(aig_rewrite, counterexample)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, AIG_REWRITE, 1);
+  vc_setFlag(vc, 'd');
+
+  Type bv16 = vc_bvType(vc, 16);
+  Expr a = vc_varExpr(vc, "a", bv16);
+  Expr b = vc_varExpr(vc, "b", bv16);
+
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, a, b),
+                                 vc_bvConstExprFromInt(vc, 16, 391)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 1)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, b, vc_bvConstExprFromInt(vc, 16, 1)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 256)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, b, vc_bvConstExprFromInt(vc, 16, 256)));
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  unsigned av = getBVUnsigned(vc_getCounterExample(vc, a));
+  unsigned bv = getBVUnsigned(vc_getCounterExample(vc, b));
+  ASSERT_EQ(391u, av * bv);
+  ASSERT_EQ(4, vc_getStatistic(vc, AIG_REWRITE_STEPS));
+
+  vc_Destroy(vc);
+}
@@ -0,0 +1,97 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include "stp/c_interface.h"
+
+// Reads at symbolic indexes need array read refinement, which adds the
+// axioms for them to the solver after the first call.
+
+TEST(array_refinement, same_index_same_value)
+{
+  VC vc = vc_createValidityChecker();
+  Type bv32 = vc_bvType(vc, 32);
+
+  Expr a = vc_bvCreateMemoryArray(vc, "a");
+  Expr i = vc_varExpr(vc, "i", bv32);
+  Expr j = vc_varExpr(vc, "j", bv32);
+
+  vc_assertFormula(vc, vc_notExpr(vc, vc_eqExpr(vc, vc_readExpr(vc, a, i),
+                                                 vc_readExpr(vc, a, j))));
+
+  // Reads that differ must be at different indexes.
+  ASSERT_EQ(1, vc_query(vc, vc_notExpr(vc, vc_eqExpr(vc, i, j))));
+
+  vc_Destroy(vc);
+}
+
+TEST(array_refinement, distinct_values)
+{
+  VC vc = vc_createValidityChecker();
+  Type bv32 = vc_bvType(vc, 32);
+
+  Expr a = vc_bvCreateMemoryArray(vc, "a");
+  const int count = 8;
+  Expr index[count];
+  for (int k = 0; k < count; k++)
+  {
+    char name[8];
+    sprintf(name, "x%d", k);
+    index[k] = vc_varExpr(vc, name, bv32);
+    vc_assertFormula(vc, vc_eqExpr(vc, vc_readExpr(vc, a, index[k]),
+                                   vc_bvConstExprFromInt(vc, 8, k)));
+  }
+
+  // The indexes must all be different, but not necessarily in order.
+  Expr distinct = vc_trueExpr(vc);
+  for (int k = 0; k < count; k++)
+    for (int l = k + 1; l < count; l++)
+      distinct = vc_andExpr(
+          vc, distinct, vc_notExpr(vc, vc_eqExpr(vc, index[k], index[l])));
+  ASSERT_EQ(1, vc_query(vc, distinct));
+  ASSERT_EQ(0, vc_query(vc, vc_bvLtExpr(vc, index[0], index[1])));
+
+  vc_Destroy(vc);
+}
+
+TEST(array_refinement, counterexample)
+{
+  VC vc = vc_createValidityChecker();
+  Type bv32 = vc_bvType(vc, 32);
+
+  Expr a = vc_bvCreateMemoryArray(vc, "a");
+  Expr i = vc_varExpr(vc, "i", bv32);
+  Expr j = vc_varExpr(vc, "j", bv32);
+
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_readExpr(vc, a, i),
+                                 vc_bvConstExprFromInt(vc, 8, 5)));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_readExpr(vc, a, j),
+                                 vc_bvConstExprFromInt(vc, 8, 6)));
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_NE(getBVUnsigned(vc_getCounterExample(vc, i)),
+            getBVUnsigned(vc_getCounterExample(vc, j)));
+
+  vc_Destroy(vc);
+}
@@ -0,0 +1,87 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include "stp/c_interface.h"
+
+TEST(assumptions, failed)
+{
+  VC vc = vc_createValidityChecker();
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 8));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 8));
+  vc_assertFormula(vc, vc_eqExpr(vc, a, b));
+
+  Expr assumed[3];
+  assumed[0] = vc_eqExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 1));
+  assumed[1] = vc_bvLtExpr(vc, b, vc_bvConstExprFromInt(vc, 8, 100));
+  assumed[2] = vc_eqExpr(vc, b, vc_bvConstExprFromInt(vc, 8, 2));
+
+  // a = b, a = 1 and b = 2 can't all hold, b < 100 isn't needed to show it.
+  ASSERT_EQ(1, vc_queryWithAssumptions(vc, assumed, 3));
+
+  Expr* failed;
+  int size;
+  vc_getFailedAssumptions(vc, &failed, &size);
+  ASSERT_EQ(2, size);
+  bool has0 = false, has2 = false;
+  for (int i = 0; i < size; i++)
+  {
+    has0 |= getExprID(failed[i]) == getExprID(assumed[0]);
+    has2 |= getExprID(failed[i]) == getExprID(assumed[2]);
+    vc_DeleteExpr(failed[i]);
+  }
+  free(failed);
+  ASSERT_TRUE(has0);
+  ASSERT_TRUE(has2);
+
+  // Nothing assumed before is kept.
+  ASSERT_EQ(0, vc_queryWithAssumptions(vc, assumed + 1, 2));
+  ASSERT_EQ(2u, getBVInt(vc_getCounterExample(vc, a)));
+
+  ASSERT_EQ(0, vc_queryWithAssumptions(vc, assumed, 2));
+  ASSERT_EQ(1u, getBVInt(vc_getCounterExample(vc, b)));
+
+  vc_Destroy(vc);
+}
+
+// If the assertions can't hold, no assumptions are needed.
+TEST(assumptions, unsatisfiable_asserts)
+{
+  VC vc = vc_createValidityChecker();
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 8));
+  vc_assertFormula(vc, vc_eqExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 1)));
+  vc_assertFormula(vc, vc_eqExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 2)));
+
+  Expr assumed = vc_bvLtExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 100));
+  ASSERT_EQ(1, vc_queryWithAssumptions(vc, &assumed, 1));
+
+  Expr* failed;
+  int size;
+  vc_getFailedAssumptions(vc, &failed, &size);
+  ASSERT_EQ(0, size);
+
+  vc_Destroy(vc);
+}
@@ -0,0 +1,89 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// Each query has to give the same answer as it would without incremental
+// solving, even though the solver has seen the earlier, popped, asserts.
+TEST(incremental, push_pop)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, INCREMENTAL, 1);
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 8));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 8));
+  Expr sum = vc_bvPlusExpr(vc, 8, a, b);
+
+  vc_assertFormula(vc, vc_bvLtExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 10)));
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_eqExpr(vc, sum, vc_bvConstExprFromInt(vc, 8, 3)));
+  vc_assertFormula(vc, vc_eqExpr(vc, b, vc_bvConstExprFromInt(vc, 8, 1)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(2u, getBVInt(vc_getCounterExample(vc, a)));
+  ASSERT_EQ(1u, getBVInt(vc_getCounterExample(vc, b)));
+
+  // a + 1 = 3 and a = 5 can't both hold.
+  ASSERT_EQ(1, vc_query(vc, vc_notExpr(vc, vc_eqExpr(
+                                              vc, a,
+                                              vc_bvConstExprFromInt(vc, 8, 5)))));
+  vc_pop(vc);
+
+  // Nothing asserted inside the pushed frame may still hold.
+  vc_push(vc);
+  vc_assertFormula(vc, vc_eqExpr(vc, a, vc_bvConstExprFromInt(vc, 8, 5)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(5u, getBVInt(vc_getCounterExample(vc, a)));
+  vc_pop(vc);
+
+  // a < 10 is still asserted.
+  ASSERT_EQ(1, vc_query(vc, vc_bvLtExpr(vc, a,
+                                        vc_bvConstExprFromInt(vc, 8, 10))));
+  ASSERT_EQ(0, vc_query(vc, vc_bvLtExpr(vc, a,
+                                        vc_bvConstExprFromInt(vc, 8, 9))));
+
+  vc_Destroy(vc);
+}
+
+// The answer has to be the same as without incremental solving when the
+// formula bit-blasts to a constant.
+TEST(incremental, constant)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, INCREMENTAL, 1);
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 4));
+
+  ASSERT_EQ(1, vc_query(vc, vc_eqExpr(vc, a, a)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_falseExpr(vc));
+  ASSERT_EQ(1, vc_query(vc, vc_falseExpr(vc)));
+  vc_pop(vc);
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+
+  vc_Destroy(vc);
+}
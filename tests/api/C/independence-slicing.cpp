@@ -0,0 +1,82 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// The model is put together from those of the separately solved slices.
+TEST(independence_slicing, sat_model)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, INDEPENDENCE_SLICING, 1);
+  vc_setFlag(vc, 'd');
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 16));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 16));
+  Expr c = vc_varExpr(vc, "c", vc_bvType(vc, 16));
+  Expr p = vc_varExpr(vc, "p", vc_boolType(vc));
+
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, a, b),
+                                 vc_bvConstExprFromInt(vc, 16, 143)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 11)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 14)));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvPlusExpr(vc, 16, c,
+                                                   vc_bvConstExprFromInt(vc, 16, 1)),
+                                 vc_bvConstExprFromInt(vc, 16, 5)));
+  vc_assertFormula(vc, p);
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(13u, getBVUnsigned(vc_getCounterExample(vc, a)));
+  ASSERT_EQ(11u, getBVUnsigned(vc_getCounterExample(vc, b)));
+  ASSERT_EQ(4u, getBVUnsigned(vc_getCounterExample(vc, c)));
+  ASSERT_EQ(1, vc_isBool(vc_getCounterExample(vc, p)));
+
+  vc_Destroy(vc);
+}
+
+// With the cache on, a slice that an earlier query solved is answered from
+// it, and only the query's slice is needed to show validity.
+TEST(independence_slicing, valid_with_cache)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, INDEPENDENCE_SLICING, 1);
+  vc_setInterfaceFlags(vc, QUERY_CACHE, 16);
+
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 32));
+  Expr y = vc_varExpr(vc, "y", vc_bvType(vc, 32));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 10)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, y, vc_bvConstExprFromInt(vc, 32, 20)));
+
+  // Both slices are solved, and both are satisfiable.
+  ASSERT_EQ(0, vc_query(vc, vc_bvGtExpr(vc, y, vc_bvConstExprFromInt(vc, 32, 25))));
+  ASSERT_EQ(0, vc_getStatistic(vc, QUERY_CACHE_HITS));
+
+  // The slice with x in it hasn't changed.
+  ASSERT_EQ(0, vc_query(vc, vc_bvGtExpr(vc, y, vc_bvConstExprFromInt(vc, 32, 30))));
+  ASSERT_EQ(1, vc_getStatistic(vc, QUERY_CACHE_HITS));
+
+  ASSERT_EQ(1, vc_query(vc, vc_bvGtExpr(vc, y, vc_bvConstExprFromInt(vc, 32, 15))));
+  ASSERT_EQ(1, vc_query(vc, vc_bvLeExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 9))));
+
+  vc_Destroy(vc);
+}
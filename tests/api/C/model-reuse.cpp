@@ -0,0 +1,89 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// The second query is satisfied by the first's model, the third isn't
+// satisfied by either, and the fourth has a symbol the models don't.
+TEST(model_reuse, reused_and_not)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, MODEL_REUSE, 4);
+  vc_setFlag(vc, 'd');
+
+  Type bv32 = vc_bvType(vc, 32);
+  Expr x = vc_varExpr(vc, "x", bv32);
+  Expr y = vc_varExpr(vc, "y", bv32);
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_eqExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 42)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(42u, getBVUnsigned(vc_getCounterExample(vc, x)));
+  ASSERT_EQ(0, vc_getStatistic(vc, MODEL_REUSE_HITS));
+  ASSERT_EQ(1, vc_getStatistic(vc, MODEL_REUSE_MISSES));
+  vc_pop(vc);
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_bvGtExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 40)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 50)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(42u, getBVUnsigned(vc_getCounterExample(vc, x)));
+  ASSERT_EQ(1, vc_getStatistic(vc, MODEL_REUSE_HITS));
+  ASSERT_EQ(1, vc_getStatistic(vc, MODEL_REUSE_MISSES));
+  vc_pop(vc);
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_eqExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 7)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(7u, getBVUnsigned(vc_getCounterExample(vc, x)));
+  ASSERT_EQ(1, vc_getStatistic(vc, MODEL_REUSE_HITS));
+  ASSERT_EQ(2, vc_getStatistic(vc, MODEL_REUSE_MISSES));
+  vc_pop(vc);
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 32, 8)));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvPlusExpr(vc, 32, x, y),
+                                 vc_bvConstExprFromInt(vc, 32, 7)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(7u, getBVUnsigned(vc_getCounterExample(vc, x)) +
+                    getBVUnsigned(vc_getCounterExample(vc, y)));
+  vc_pop(vc);
+
+  vc_Destroy(vc);
+}
+
+// Reuse never makes an unsatisfiable query satisfiable.
+TEST(model_reuse, unsat)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, MODEL_REUSE, 4);
+
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 8));
+  ASSERT_EQ(0, vc_query(vc, vc_eqExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 3))));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 3)));
+  ASSERT_EQ(1, vc_query(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 4))));
+  ASSERT_EQ(0, vc_getStatistic(vc, MODEL_REUSE_HITS));
+
+  vc_Destroy(vc);
+}
@@ -0,0 +1,81 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// a*b and c*d share no symbols, so they're bit-blasted on different
+// threads. The model has to come back for the symbols of both.
+TEST(parallel_bitblast, independent)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, BITBLAST_THREADS, 2);
+
+  Type bv16 = vc_bvType(vc, 16);
+  Expr a = vc_varExpr(vc, "a", bv16);
+  Expr b = vc_varExpr(vc, "b", bv16);
+  Expr c = vc_varExpr(vc, "c", bv16);
+  Expr d = vc_varExpr(vc, "d", bv16);
+  Expr one = vc_bvConstExprFromInt(vc, 16, 1);
+  Expr limit = vc_bvConstExprFromInt(vc, 16, 256);
+
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, a, b),
+                                 vc_bvConstExprFromInt(vc, 16, 143)));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, c, d),
+                                 vc_bvConstExprFromInt(vc, 16, 221)));
+  Expr vars[] = {a, b, c, d};
+  for (int i = 0; i < 4; i++)
+  {
+    vc_assertFormula(vc, vc_bvGtExpr(vc, vars[i], one));
+    vc_assertFormula(vc, vc_bvLtExpr(vc, vars[i], limit));
+  }
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  unsigned av = getBVUnsigned(vc_getCounterExample(vc, a));
+  unsigned bv = getBVUnsigned(vc_getCounterExample(vc, b));
+  unsigned cv = getBVUnsigned(vc_getCounterExample(vc, c));
+  unsigned dv = getBVUnsigned(vc_getCounterExample(vc, d));
+  ASSERT_EQ(143u, av * bv);
+  ASSERT_EQ(221u, cv * dv);
+
+  vc_Destroy(vc);
+}
+
+// The same symbol bit-blasted by two threads has to end up as one input.
+TEST(parallel_bitblast, shared_symbol)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, BITBLAST_THREADS, 4);
+
+  Type bv8 = vc_bvType(vc, 8);
+  Expr x = vc_varExpr(vc, "x", bv8);
+
+  vc_assertFormula(vc, vc_bvGtExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 10)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 12)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(11u, getBVUnsigned(vc_getCounterExample(vc, x)));
+
+  ASSERT_EQ(1, vc_query(vc, vc_eqExpr(vc, x, vc_bvConstExprFromInt(vc, 8, 11))));
+
+  vc_Destroy(vc);
+}
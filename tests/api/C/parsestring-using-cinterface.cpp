@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include <gtest/gtest.h>
 #include <stdio.h>
+#include <string.h>
 #include "stp/c_interface.h"
 
 TEST(parse_string, CVC)
@@ -80,3 +81,29 @@ TEST(parse_string, SMT)
   // FIXME: Actually test something
   // ASSERT_TRUE(false && "FIXME: Actually test something");
 }
+
+TEST(parse_string, CVC_in_place)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setFlags(vc, 'n');
+  vc_setFlags(vc, 'd');
+
+  Expr q;
+  Expr asserts;
+
+  const char s[] = "QUERY BVMOD(2,0bin10,0bin10) = 0bin00;\n";
+  const unsigned long length = sizeof(s) - 1;
+
+  // The input followed by two NUL bytes.
+  char buffer[sizeof(s) + 1];
+  memcpy(buffer, s, sizeof(s));
+  buffer[length + 1] = '\0';
+
+  ASSERT_EQ(1, vc_parseMemBuffer(vc, buffer, length, &q, &asserts));
+  ASSERT_EQ(0, memcmp(buffer, s, sizeof(s)));
+  ASSERT_EQ(1, vc_query(vc, q));
+
+  vc_DeleteExpr(q);
+  vc_DeleteExpr(asserts);
+  vc_Destroy(vc);
+}
@@ -0,0 +1,89 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// Whichever configuration wins, the model has to be imported back into the
+// caller's manager and satisfy the original formula.
+TEST(portfolio, sat_model)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, PORTFOLIO, 4);
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 16));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 16));
+
+  // a * b = 143, neither factor is 1.
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, a, b),
+                                 vc_bvConstExprFromInt(vc, 16, 143)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 1)));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, b, vc_bvConstExprFromInt(vc, 16, 1)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, a, vc_bvConstExprFromInt(vc, 16, 256)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, b, vc_bvConstExprFromInt(vc, 16, 256)));
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  unsigned av = getBVUnsigned(vc_getCounterExample(vc, a));
+  unsigned bv = getBVUnsigned(vc_getCounterExample(vc, b));
+  ASSERT_EQ(143u, (av * bv) & 0xffff);
+  ASSERT_TRUE(av == 11 || av == 13);
+
+  vc_Destroy(vc);
+}
+
+TEST(portfolio, array_model)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, PORTFOLIO, 3);
+
+  Type index = vc_bvType(vc, 8);
+  Expr arr = vc_varExpr(vc, "arr", vc_arrayType(vc, index, index));
+  Expr i = vc_varExpr(vc, "i", index);
+
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_readExpr(vc, arr, i),
+                                 vc_bvConstExprFromInt(vc, 8, 42)));
+  vc_assertFormula(vc, vc_eqExpr(vc, i, vc_bvConstExprFromInt(vc, 8, 7)));
+
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(7u, getBVUnsigned(vc_getCounterExample(vc, i)));
+  ASSERT_EQ(42u, getBVUnsigned(vc_getCounterExample(
+                     vc, vc_readExpr(vc, arr, vc_bvConstExprFromInt(vc, 8, 7)))));
+
+  vc_Destroy(vc);
+}
+
+TEST(portfolio, unsat)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, PORTFOLIO, 4);
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 12));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 12));
+
+  // Multiplication commutes, whichever encoding each worker uses.
+  Expr ab = vc_bvMultExpr(vc, 12, a, b);
+  Expr ba = vc_bvMultExpr(vc, 12, b, a);
+  ASSERT_EQ(1, vc_query(vc, vc_eqExpr(vc, ab, ba)));
+
+  vc_Destroy(vc);
+}
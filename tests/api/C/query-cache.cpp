@@ -0,0 +1,151 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "stp/c_interface.h"
+
+// The second query differs from the first only in the names of its
+// symbols and the order of a conjunction, so it's answered from the
+// cache. The model has to be given in terms of the new symbols.
+TEST(query_cache, renamed_sat)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, QUERY_CACHE, 8);
+  vc_setFlag(vc, 'd');
+
+  Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 40));
+  Expr b = vc_varExpr(vc, "b", vc_bvType(vc, 40));
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 40));
+  Expr y = vc_varExpr(vc, "y", vc_bvType(vc, 40));
+
+  Expr c7 = vc_bvConstExprFromLL(vc, 40, 0x7123456789ULL);
+  Expr c3 = vc_bvConstExprFromInt(vc, 40, 3);
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_andExpr(vc, vc_eqExpr(vc, vc_bvPlusExpr(vc, 40, a, b), c7),
+                                  vc_eqExpr(vc, b, c3)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(0x7123456786ULL, getBVUnsignedLongLong(vc_getCounterExample(vc, a)));
+  vc_pop(vc);
+  ASSERT_EQ(0, vc_getStatistic(vc, QUERY_CACHE_HITS));
+  ASSERT_EQ(1, vc_getStatistic(vc, QUERY_CACHE_MISSES));
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_andExpr(vc, vc_eqExpr(vc, y, c3),
+                                  vc_eqExpr(vc, vc_bvPlusExpr(vc, 40, x, y), c7)));
+  ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+  ASSERT_EQ(0x7123456786ULL, getBVUnsignedLongLong(vc_getCounterExample(vc, x)));
+  ASSERT_EQ(3ULL, getBVUnsignedLongLong(vc_getCounterExample(vc, y)));
+  vc_pop(vc);
+  ASSERT_EQ(1, vc_getStatistic(vc, QUERY_CACHE_HITS));
+  ASSERT_EQ(1, vc_getStatistic(vc, QUERY_CACHE_MISSES));
+
+  vc_Destroy(vc);
+}
+
+// No square is 2 mod 256, but 4 is. The cache holds a single answer, so
+// the third query pushes out the second.
+TEST(query_cache, unsat)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, QUERY_CACHE, 1);
+
+  Expr p = vc_varExpr(vc, "p", vc_bvType(vc, 8));
+  Expr q = vc_varExpr(vc, "q", vc_bvType(vc, 8));
+  Expr two = vc_bvConstExprFromInt(vc, 8, 2);
+  Expr four = vc_bvConstExprFromInt(vc, 8, 4);
+
+  Expr pp = vc_bvMultExpr(vc, 8, p, p);
+  Expr qq = vc_bvMultExpr(vc, 8, q, q);
+  ASSERT_EQ(1, vc_query(vc, vc_notExpr(vc, vc_eqExpr(vc, pp, two))));
+  ASSERT_EQ(1, vc_query(vc, vc_notExpr(vc, vc_eqExpr(vc, qq, two))));
+  ASSERT_EQ(0, vc_query(vc, vc_notExpr(vc, vc_eqExpr(vc, qq, four))));
+  ASSERT_EQ(1, vc_query(vc, vc_notExpr(vc, vc_eqExpr(vc, pp, two))));
+  // Only the renamed second query was a hit.
+  ASSERT_EQ(1, vc_getStatistic(vc, QUERY_CACHE_HITS));
+  ASSERT_EQ(3, vc_getStatistic(vc, QUERY_CACHE_MISSES));
+
+  vc_Destroy(vc);
+}
+
+// A second validity checker, standing in for another process, finds the
+// answer and model that the first left in the file.
+TEST(query_cache, file)
+{
+  const char* path = "query-cache-test.stpqc";
+  std::remove(path);
+
+  VC first = vc_createValidityChecker();
+  vc_setQueryCacheFile(first, path);
+  vc_setFlag(first, 'd');
+  Expr a = vc_varExpr(first, "a", vc_bvType(first, 16));
+  vc_assertFormula(first, vc_eqExpr(first, vc_bvMultExpr(first, 16, a, a),
+                                    vc_bvConstExprFromInt(first, 16, 169)));
+  vc_assertFormula(first, vc_bvLtExpr(first, a, vc_bvConstExprFromInt(first, 16, 100)));
+  ASSERT_EQ(0, vc_query(first, vc_falseExpr(first)));
+  ASSERT_EQ(13u, getBVUnsigned(vc_getCounterExample(first, a)));
+  ASSERT_EQ(0, vc_getStatistic(first, QUERY_CACHE_FILE_HITS));
+  vc_Destroy(first);
+
+  VC second = vc_createValidityChecker();
+  vc_setQueryCacheFile(second, path);
+  vc_setFlag(second, 'd');
+  Expr b = vc_varExpr(second, "b", vc_bvType(second, 16));
+  vc_assertFormula(second, vc_eqExpr(second, vc_bvMultExpr(second, 16, b, b),
+                                     vc_bvConstExprFromInt(second, 16, 169)));
+  vc_assertFormula(second, vc_bvLtExpr(second, b, vc_bvConstExprFromInt(second, 16, 100)));
+  ASSERT_EQ(0, vc_query(second, vc_falseExpr(second)));
+  ASSERT_EQ(13u, getBVUnsigned(vc_getCounterExample(second, b)));
+  ASSERT_EQ(1, vc_getStatistic(second, QUERY_CACHE_FILE_HITS));
+  vc_Destroy(second);
+
+  std::remove(path);
+}
+
+// A file whose kind table doesn't match this build's is ignored, and
+// started again when the first answer is stored in it.
+TEST(query_cache, file_from_another_build)
+{
+  const char* path = "query-cache-other-build.stpqc";
+  FILE* f = std::fopen(path, "wb");
+  ASSERT_TRUE(f != NULL);
+  const char header[24] = {'S', 'T', 'P', 'Q', 'u', 'e', 'r', 'y',
+                           'C', 'a', 'c', 'h', 'e', ' ', 'v', '2',
+                           1,   2,   3,   4,   5,   6,   7,   8};
+  ASSERT_EQ(sizeof(header), std::fwrite(header, 1, sizeof(header), f));
+  std::fclose(f);
+
+  for (int i = 0; i < 2; i++)
+  {
+    VC vc = vc_createValidityChecker();
+    vc_setQueryCacheFile(vc, path);
+    Expr a = vc_varExpr(vc, "a", vc_bvType(vc, 8));
+    vc_assertFormula(vc, vc_bvLtExpr(vc, vc_bvConstExprFromInt(vc, 8, 200), a));
+    ASSERT_EQ(0, vc_query(vc, vc_falseExpr(vc)));
+    ASSERT_EQ(i, vc_getStatistic(vc, QUERY_CACHE_FILE_HITS));
+    vc_Destroy(vc);
+  }
+
+  std::remove(path);
+}
@@ -0,0 +1,173 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string>
+#include "stp/c_interface.h"
+#include "stp/Parser/BinaryReader.h"
+#include "stp/Printer/BinaryFormat.h"
+#include "stp/STPManager/STP.h"
+
+// Builds a formula with arrays, a constant wider than a machine word and
+// shared subterms, over variables a and m.
+static Expr build(VC vc)
+{
+  Type bv8 = vc_bvType(vc, 8);
+  Type bv32 = vc_bvType(vc, 32);
+  Expr a = vc_varExpr(vc, "a", bv32);
+  Expr m = vc_varExpr(vc, "m", vc_arrayType(vc, bv32, bv8));
+
+  Expr wide = vc_bvConstExprFromStr(
+      vc, "1011001110001111000011111000001111110000001111111000000011");
+  Expr sum = vc_bvPlusExpr(vc, 32, a, vc_bvConstExprFromInt(vc, 32, 7));
+  Expr stored = vc_writeExpr(vc, m, sum, vc_bvExtract(vc, sum, 7, 0));
+  Expr read = vc_readExpr(vc, stored, sum);
+  Expr concat = vc_bvConcatExpr(vc, wide, read);
+
+  return vc_andExpr(
+      vc, vc_eqExpr(vc, vc_bvExtract(vc, concat, 7, 0), vc_bvExtract(vc, sum, 7, 0)),
+      vc_iteExpr(vc, vc_bvLtExpr(vc, a, sum), vc_trueExpr(vc),
+                 vc_eqExpr(vc, a, vc_bvConstExprFromInt(vc, 32, 255))));
+}
+
+TEST(serialize, same_vc)
+{
+  VC vc = vc_createValidityChecker();
+  Expr e = build(vc);
+
+  char* buf;
+  unsigned long len;
+  vc_serializeExpr(vc, e, &buf, &len);
+  Expr back = vc_deserializeExpr(vc, buf, len);
+  free(buf);
+
+  char* before = exprString(e);
+  char* after = exprString(back);
+  ASSERT_STREQ(before, after);
+  free(before);
+  free(after);
+
+  vc_Destroy(vc);
+}
+
+// Another validity checker, as another process would have, rebuilds the
+// same variables and gets the same answer.
+TEST(serialize, other_vc)
+{
+  VC writer = vc_createValidityChecker();
+  char* buf;
+  unsigned long len;
+  vc_serializeExpr(writer, build(writer), &buf, &len);
+  vc_Destroy(writer);
+
+  VC reader = vc_createValidityChecker();
+  Expr e = vc_deserializeExpr(reader, buf, len);
+  free(buf);
+
+  // Only fails when a + 7 wraps around.
+  ASSERT_EQ(0, vc_query(reader, e));
+  Expr a = vc_varExpr(reader, "a", vc_bvType(reader, 32));
+  unsigned av = getBVUnsigned(vc_getCounterExample(reader, a));
+  ASSERT_GE(av, 0xfffffff9u);
+
+  vc_Destroy(reader);
+}
+
+static bool tryRead(VC vc, const std::string& data, std::string& error)
+{
+  stp::ASTNode n;
+  return stp::Binary_TryRead(*((stp::STP*)vc)->bm, data.data(), data.size(),
+                             n, error);
+}
+
+static std::string serialized(VC vc, Expr e)
+{
+  char* buf;
+  unsigned long len;
+  vc_serializeExpr(vc, e, &buf, &len);
+  std::string s(buf, len);
+  free(buf);
+  return s;
+}
+
+// Input that doesn't hold what it says it does is turned down before
+// anything is made from it.
+TEST(serialize, malformed)
+{
+  VC vc = vc_createValidityChecker();
+  std::string error;
+
+  std::string header(stp::binary::MAGIC, sizeof(stp::binary::MAGIC));
+  stp::binary::putU32(header, stp::binary::VERSION);
+
+  std::string manySymbols(header);
+  stp::binary::putU32(manySymbols, 0xffffffff);
+  ASSERT_FALSE(tryRead(vc, manySymbols, error));
+  ASSERT_EQ("Binary_Read: truncated input", error);
+
+  std::string badKind(header);
+  stp::binary::putU32(badKind, 0);
+  stp::binary::putU32(badKind, 1);
+  badKind += (char)255;
+  stp::binary::putU32(badKind, 0);
+  stp::binary::putU32(badKind, 0);
+  ASSERT_FALSE(tryRead(vc, badKind, error));
+  ASSERT_EQ("Binary_Read: bad kind", error);
+
+  vc_Destroy(vc);
+}
+
+// A symbol that's already there keeps its width, and a node that doesn't
+// type check isn't accepted.
+TEST(serialize, ill_typed)
+{
+  VC writer = vc_createValidityChecker();
+  Type bv8 = vc_bvType(writer, 8);
+  Expr a = vc_varExpr(writer, "a", vc_bvType(writer, 32));
+  std::string wideA = serialized(writer, vc_eqExpr(writer, a, a));
+  std::string sum = serialized(
+      writer, vc_bvPlusExpr(writer, 8, vc_varExpr(writer, "b", bv8),
+                            vc_varExpr(writer, "c", bv8)));
+  vc_Destroy(writer);
+
+  VC reader = vc_createValidityChecker();
+  std::string error;
+  Expr narrowA = vc_varExpr(reader, "a", vc_bvType(reader, 8));
+  ASSERT_FALSE(tryRead(reader, wideA, error));
+  ASSERT_EQ("Binary_Read: symbol a has another width here", error);
+  ASSERT_EQ(8, vc_getBVLength(reader, narrowA));
+
+  // The root is the sum, written last as its kind, its value width, its
+  // index width, and its two children.
+  const size_t width = sum.size() - 3 * 4 - 2 * 4;
+  std::string wideSum(sum);
+  wideSum.replace(width, 4, std::string("\x10\0\0\0", 4));
+  testing::internal::CaptureStderr();
+  ASSERT_FALSE(tryRead(reader, wideSum, error));
+  ASSERT_EQ("", testing::internal::GetCapturedStderr());
+  ASSERT_EQ("Binary_Read: operand of the wrong width", error);
+  ASSERT_TRUE(tryRead(reader, sum, error));
+
+  vc_Destroy(reader);
+}
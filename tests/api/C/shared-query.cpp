@@ -0,0 +1,167 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <string>
+#include "stp/c_interface.h"
+#include "stp/Interface/SharedQuery.h"
+
+static void submit(VC vc, stp::SharedQuery& segment, Expr query)
+{
+  char* buf;
+  unsigned long len;
+  vc_serializeExpr(vc, query, &buf, &len);
+  ASSERT_LE(len, segment.capacity());
+  memcpy(segment.data(), buf, len);
+  free(buf);
+  segment.submit(len);
+}
+
+// A worker process, as with "stp --shm-worker".
+static pid_t startWorker(const std::string& name)
+{
+  pid_t worker = fork();
+  if (worker == 0)
+  {
+    VC vc = vc_createValidityChecker();
+    stp::SharedQuery view;
+    if (!view.open(name.c_str()))
+      _exit(1);
+    view.serve((stp::STP*)vc);
+    vc_Destroy(vc);
+    _exit(0);
+  }
+  return worker;
+}
+
+static void stopWorker(stp::SharedQuery& segment, pid_t worker)
+{
+  segment.shutdown();
+  int status;
+  ASSERT_EQ(worker, waitpid(worker, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+}
+
+static std::string segmentName()
+{
+  return "/stp-shared-query-" + std::to_string(getpid());
+}
+
+// A producer and a worker process.
+TEST(shared_query, two_processes)
+{
+  const std::string name = segmentName();
+  stp::SharedQuery segment;
+  ASSERT_TRUE(segment.create(name.c_str(), 1 << 16));
+  pid_t worker = startWorker(name);
+  ASSERT_NE(-1, worker);
+
+  VC vc = vc_createValidityChecker();
+  Type bv32 = vc_bvType(vc, 32);
+  Expr x = vc_varExpr(vc, "x", bv32);
+  Expr seven = vc_bvConstExprFromInt(vc, 32, 7);
+  Expr sum = vc_bvPlusExpr(vc, 32, x, vc_bvConstExprFromInt(vc, 32, 3));
+
+  // Invalid only when x is 7, which comes back as the model.
+  submit(vc, segment, vc_notExpr(vc, vc_eqExpr(vc, sum, vc_bvConstExprFromInt(vc, 32, 10))));
+  ASSERT_EQ(0, segment.waitForResult());
+  ASSERT_GT(segment.modelLength(), 0u);
+  Expr model = vc_deserializeExpr(vc, segment.data(), segment.modelLength());
+  ASSERT_EQ(1, vc_query(vc, vc_impliesExpr(vc, model, vc_eqExpr(vc, x, seven))));
+
+  submit(vc, segment, vc_eqExpr(vc, sum, vc_bvPlusExpr(vc, 32, vc_bvConstExprFromInt(vc, 32, 3), x)));
+  ASSERT_EQ(1, segment.waitForResult());
+
+  stopWorker(segment, worker);
+  vc_Destroy(vc);
+}
+
+// Input that isn't a query is answered with an error, and the worker
+// carries on.
+TEST(shared_query, malformed)
+{
+  const std::string name = segmentName();
+  stp::SharedQuery segment;
+  ASSERT_TRUE(segment.create(name.c_str(), 1 << 16));
+  pid_t worker = startWorker(name);
+  ASSERT_NE(-1, worker);
+
+  VC vc = vc_createValidityChecker();
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 16));
+  Expr query = vc_eqExpr(vc, vc_bvXorExpr(vc, x, x), vc_bvConstExprFromInt(vc, 16, 0));
+
+  memcpy(segment.data(), "garbage", 7);
+  segment.submit(7);
+  ASSERT_EQ(-100, segment.waitForResult());
+
+  char* buf;
+  unsigned long len;
+  vc_serializeExpr(vc, query, &buf, &len);
+  memcpy(segment.data(), buf, len);
+  free(buf);
+  segment.submit(len - 1);
+  ASSERT_EQ(-100, segment.waitForResult());
+
+  // A term rather than a formula.
+  submit(vc, segment, x);
+  ASSERT_EQ(-100, segment.waitForResult());
+
+  submit(vc, segment, query);
+  ASSERT_EQ(1, segment.waitForResult());
+
+  stopWorker(segment, worker);
+  vc_Destroy(vc);
+}
+
+// The producer isn't left waiting for a worker that has died.
+TEST(shared_query, worker_dies)
+{
+  const std::string name = segmentName();
+  stp::SharedQuery segment;
+  ASSERT_TRUE(segment.create(name.c_str(), 1 << 16));
+  pid_t worker = startWorker(name);
+  ASSERT_NE(-1, worker);
+
+  VC vc = vc_createValidityChecker();
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 16));
+  Expr query = vc_eqExpr(vc, x, x);
+
+  // Answered, so the worker is serving.
+  submit(vc, segment, query);
+  ASSERT_EQ(1, segment.waitForResult());
+
+  ASSERT_EQ(0, kill(worker, SIGKILL));
+  int status;
+  ASSERT_EQ(worker, waitpid(worker, &status, 0));
+
+  submit(vc, segment, query);
+  ASSERT_EQ(-100, segment.waitForResult());
+
+  vc_Destroy(vc);
+}
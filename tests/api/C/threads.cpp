@@ -0,0 +1,144 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+#include "stp/c_interface.h"
+
+namespace
+{
+const int num_threads = 8;
+const int rounds = 4;
+
+// Finds the two (16-bit) factors of product with a solver of its own.
+bool factor(unsigned product, unsigned& x_out, unsigned& y_out)
+{
+  VC vc = vc_createValidityChecker();
+
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 32));
+  Expr y = vc_varExpr(vc, "y", vc_bvType(vc, 32));
+  Expr one = vc_bvConstExprFromInt(vc, 32, 1);
+  Expr limit = vc_bvConstExprFromInt(vc, 32, 1 << 16);
+
+  vc_assertFormula(vc, vc_bvGtExpr(vc, x, one));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, y, one));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, limit));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, y, limit));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 32, x, y),
+                                 vc_bvConstExprFromInt(vc, 32, product)));
+
+  bool found = (0 == vc_query(vc, vc_falseExpr(vc)));
+  if (found)
+  {
+    x_out = getBVUnsigned(vc_getCounterExample(vc, x));
+    y_out = getBVUnsigned(vc_getCounterExample(vc, y));
+  }
+  vc_Destroy(vc);
+  return found;
+}
+
+// z only appears once, so it's removed as an unconstrained variable before
+// bit-blasting, and then given a value that satisfies the equation.
+bool unconstrained(unsigned i)
+{
+  VC vc = vc_createValidityChecker();
+
+  Expr x = vc_varExpr(vc, "x", vc_bvType(vc, 32));
+  Expr z = vc_varExpr(vc, "z", vc_bvType(vc, 32));
+  Expr c = vc_bvConstExprFromInt(vc, 32, 1000 + i);
+
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 32, i)));
+  vc_assertFormula(
+      vc, vc_eqExpr(vc, vc_bvPlusExpr(vc, 32, vc_bvMultExpr(vc, 32, x, x), z),
+                    c));
+
+  bool found = (0 == vc_query(vc, vc_falseExpr(vc)));
+  if (found)
+  {
+    const unsigned xv = getBVUnsigned(vc_getCounterExample(vc, x));
+    const unsigned zv = getBVUnsigned(vc_getCounterExample(vc, z));
+    found = xv < i && xv * xv + zv == 1000 + i;
+  }
+  vc_Destroy(vc);
+  return found;
+}
+
+// Goes through the (serialised) parser, then solves what it read.
+int parse_and_query(int i)
+{
+  VC vc = vc_createValidityChecker();
+
+  char s[100];
+  snprintf(s, sizeof(s), "QUERY BVMOD(8,0hex%02x,0hex07) = 0hex%02x;\n",
+           i + 16, (i + 16) % 7);
+
+  Expr q;
+  Expr asserts;
+  vc_parseMemExpr(vc, s, &q, &asserts);
+  vc_assertFormula(vc, asserts);
+  int result = vc_query(vc, q);
+
+  vc_DeleteExpr(q);
+  vc_DeleteExpr(asserts);
+  vc_Destroy(vc);
+  return result;
+}
+}
+
+// Independent validity checkers used from several threads at once must give
+// the same answers as when they are used one after the other.
+TEST(threads, independent_instances)
+{
+  const unsigned primes[num_threads][2] = {{251, 241}, {239, 233}, {229, 227},
+                                           {223, 211}, {199, 197}, {193, 191},
+                                           {181, 179}, {173, 167}};
+
+  std::vector<int> failures(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++)
+  {
+    threads.push_back(std::thread([t, &primes, &failures]() {
+      for (int r = 0; r < rounds; r++)
+      {
+        const unsigned product = primes[t][0] * primes[t][1];
+        unsigned x = 0, y = 0;
+        if (!factor(product, x, y) || x * y != product)
+          failures[t]++;
+
+        if (parse_and_query(t * rounds + r) != 1)
+          failures[t]++;
+
+        if (!unconstrained(t * rounds + r + 1))
+          failures[t]++;
+      }
+    }));
+  }
+
+  for (size_t t = 0; t < threads.size(); t++)
+    threads[t].join();
+
+  for (int t = 0; t < num_threads; t++)
+    ASSERT_EQ(0, failures[t]) << "thread " << t;
+}
@@ -52,3 +52,34 @@ TEST(timeout, one)
   // FIXME: Actually test something
   // ASSERT_TRUE(false && "FIXME: Actually test something");
 }
+
+// The timeout is in wall-clock milliseconds and also covers bit-blasting,
+// so factoring a large product gives up almost straight away.
+TEST(timeout, wall_clock)
+{
+  VC vc = vc_createValidityChecker();
+
+  Type bv64 = vc_bvType(vc, 64);
+  Expr x = vc_varExpr(vc, "x", bv64);
+  Expr y = vc_varExpr(vc, "y", bv64);
+  Expr one = vc_bvConstExprFromLL(vc, 64, 1);
+  vc_assertFormula(vc, vc_bvGtExpr(vc, x, one));
+  vc_assertFormula(vc, vc_bvGtExpr(vc, y, one));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromLL(vc, 64, 1ULL << 32)));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, y, vc_bvConstExprFromLL(vc, 64, 1ULL << 32)));
+  vc_assertFormula(
+      vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 64, x, y),
+                    vc_bvConstExprFromLL(vc, 64, 18446744030759878681ULL)));
+
+  time_t start = time(NULL);
+  ASSERT_EQ(3, vc_query_with_timeout(vc, vc_falseExpr(vc), 1));
+  ASSERT_LT(time(NULL) - start, 10);
+
+  // An earlier timeout doesn't affect the next query.
+  vc_push(vc);
+  vc_assertFormula(vc, vc_eqExpr(vc, x, vc_bvConstExprFromLL(vc, 64, 4294967291ULL)));
+  ASSERT_EQ(0, vc_query_with_timeout(vc, vc_falseExpr(vc), -1));
+  vc_pop(vc);
+
+  vc_Destroy(vc);
+}
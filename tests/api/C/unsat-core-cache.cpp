@@ -0,0 +1,60 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include "stp/c_interface.h"
+
+// A path condition keeps growing past an infeasible prefix. Every later
+// query has the core of the first, so they're valid without solving,
+// while a query without it still gets solved.
+TEST(unsat_core_cache, growing_prefix)
+{
+  VC vc = vc_createValidityChecker();
+  vc_setInterfaceFlags(vc, UNSAT_CORE_CACHE, 8);
+  vc_setFlag(vc, 'd');
+
+  Type bv16 = vc_bvType(vc, 16);
+  Expr x = vc_varExpr(vc, "x", bv16);
+  Expr y = vc_varExpr(vc, "y", bv16);
+  Expr z = vc_varExpr(vc, "z", bv16);
+  Expr ten = vc_bvConstExprFromInt(vc, 16, 10);
+  Expr query = vc_bvLeExpr(vc, x, ten);
+
+  vc_assertFormula(vc, vc_bvLtExpr(vc, x, vc_bvConstExprFromInt(vc, 16, 5)));
+  vc_assertFormula(vc, vc_eqExpr(vc, vc_bvMultExpr(vc, 16, y, y),
+                                 vc_bvConstExprFromInt(vc, 16, 49)));
+  ASSERT_EQ(1, vc_query(vc, query));
+
+  vc_push(vc);
+  vc_assertFormula(vc, vc_bvGtExpr(vc, z, y));
+  ASSERT_EQ(1, vc_query(vc, query));
+  vc_assertFormula(vc, vc_bvLtExpr(vc, z, vc_bvConstExprFromInt(vc, 16, 100)));
+  ASSERT_EQ(1, vc_query(vc, query));
+  vc_pop(vc);
+
+  ASSERT_EQ(0, vc_query(vc, vc_bvLeExpr(vc, x, vc_bvConstExprFromInt(vc, 16, 3))));
+  unsigned xv = getBVUnsigned(vc_getCounterExample(vc, x));
+  ASSERT_EQ(4u, xv);
+
+  vc_Destroy(vc);
+}
@@ -0,0 +1,9 @@
+; RUN: not %solver --aig-rewrite --aig-rewrite-script rw,xx %s 2>&1 | %OutputCheck %s
+; A step that isn't known is found before anything is solved.
+; CHECK: Invalid value 'rw,xx' given to option 'aig-rewrite-script'
+; CHECK-NOT: sat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(assert (= a (_ bv1 8)))
+(check-sat)
+(exit)
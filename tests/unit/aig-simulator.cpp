@@ -0,0 +1,117 @@
+/***********
+AUTHORS:   STP contributors
+
+BEGIN DATE: October, 2026
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**********************/
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "stp/ToSat/AIG/AIGSimulator.h"
+
+using stp::AIGSimulator;
+
+// Fanins are picked at random, complemented half the time.
+static Aig_Man_t* randomAig(unsigned inputs, unsigned nodes)
+{
+  Aig_Man_t* p = Aig_ManStart(nodes);
+  std::mt19937 rng(7);
+  std::vector<Aig_Obj_t*> objs;
+  for (unsigned i = 0; i < inputs; i++)
+    objs.push_back(Aig_ObjCreatePi(p));
+  while (Aig_ManNodeNum(p) < (int)nodes)
+  {
+    Aig_Obj_t* a = objs[rng() % objs.size()];
+    Aig_Obj_t* b = objs[rng() % objs.size()];
+    objs.push_back(
+        Aig_And(p, Aig_NotCond(a, rng() & 1), Aig_NotCond(b, rng() & 1)));
+  }
+  for (unsigned i = 0; i < 32; i++)
+    Aig_ObjCreatePo(p, objs[objs.size() - 1 - i]);
+  return p;
+}
+
+// The scalar kernel against the nodes' definitions.
+TEST(aig_simulator, scalar)
+{
+  Aig_Man_t* p = randomAig(16, 500);
+  AIGSimulator sim(p, 3);
+  sim.setKernel(AIGSimulator::SCALAR);
+  sim.randomize(1);
+  sim.simulate();
+
+  for (int i = 0; i < Aig_ManObjNumMax(p); i++)
+  {
+    Aig_Obj_t* o = Aig_ManObj(p, i);
+    if (o == NULL || !Aig_ObjIsNode(o))
+      continue;
+    const uint64_t* v0 = sim.values(Aig_ObjFanin0(o));
+    const uint64_t* v1 = sim.values(Aig_ObjFanin1(o));
+    for (int w = 0; w < sim.words(); w++)
+    {
+      const uint64_t a = Aig_ObjFaninC0(o) ? ~v0[w] : v0[w];
+      const uint64_t b = Aig_ObjFaninC1(o) ? ~v1[w] : v1[w];
+      ASSERT_EQ(a & b, sim.values(o)[w]);
+    }
+  }
+
+  Aig_ManStop(p);
+}
+
+// Every kernel the CPU has gives the scalar kernel's values, including
+// for numbers of words that leave a tail after the wide steps.
+TEST(aig_simulator, kernels_agree)
+{
+  Aig_Man_t* p = randomAig(64, 3000);
+  const AIGSimulator::Kernel kernels[] = {AIGSimulator::AVX2,
+                                          AIGSimulator::AVX512};
+  const int words[] = {1, 3, 4, 5, 8, 13, 16};
+
+  for (unsigned i = 0; i < sizeof(words) / sizeof(words[0]); i++)
+  {
+    AIGSimulator reference(p, words[i]);
+    reference.setKernel(AIGSimulator::SCALAR);
+    reference.randomize(words[i]);
+    reference.simulate();
+
+    for (unsigned k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+      if (!AIGSimulator::supported(kernels[k]))
+        continue;
+      SCOPED_TRACE(AIGSimulator::name(kernels[k]));
+
+      AIGSimulator sim(p, words[i]);
+      sim.setKernel(kernels[k]);
+      sim.randomize(words[i]);
+      sim.simulate();
+
+      for (int o = 0; o < Aig_ManObjNumMax(p); o++)
+      {
+        Aig_Obj_t* obj = Aig_ManObj(p, o);
+        if (obj == NULL || Aig_ObjIsPo(obj))
+          continue;
+        for (int w = 0; w < words[i]; w++)
+          ASSERT_EQ(reference.values(obj)[w], sim.values(obj)[w]);
+      }
+    }
+  }
+
+  Aig_ManStop(p);
+}
@@ -0,0 +1,171 @@
+/**********
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+*************/
+
+// Times AIGSimulator's kernels on two large AIGs: an array multiplier,
+// whose nodes are mostly in carry chains, and a random AIG. Each kernel
+// runs for a while at 4, 8 and 16 words per node, and its outputs are
+// checked against the scalar kernel's.
+//   aig_sim_bench [multiplier-width] [random-nodes] [seconds-per-run]
+
+#include "stp/ToSat/AIG/AIGSimulator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace stp;
+
+namespace
+{
+
+typedef std::vector<Aig_Obj_t*> Word;
+
+Word add(Aig_Man_t* p, const Word& a, const Word& b)
+{
+  Word r;
+  Aig_Obj_t* carry = Aig_ManConst0(p);
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    Aig_Obj_t* s = Aig_Exor(p, a[i], b[i]);
+    r.push_back(Aig_Exor(p, s, carry));
+    carry = Aig_Or(p, Aig_And(p, a[i], b[i]), Aig_And(p, carry, s));
+  }
+  return r;
+}
+
+Aig_Man_t* multiplier(unsigned width)
+{
+  Aig_Man_t* p = Aig_ManStart(0);
+  Word a, b;
+  for (unsigned i = 0; i < width; i++)
+    a.push_back(Aig_ObjCreatePi(p));
+  for (unsigned i = 0; i < width; i++)
+    b.push_back(Aig_ObjCreatePi(p));
+
+  Word product(2 * width, Aig_ManConst0(p));
+  for (unsigned i = 0; i < width; i++)
+  {
+    Word partial(2 * width, Aig_ManConst0(p));
+    for (unsigned j = 0; j < width; j++)
+      partial[i + j] = Aig_And(p, a[j], b[i]);
+    product = add(p, product, partial);
+  }
+  for (unsigned i = 0; i < product.size(); i++)
+    Aig_ObjCreatePo(p, product[i]);
+  return p;
+}
+
+// Fanins are mostly recent nodes, so it's deep as well as wide.
+Aig_Man_t* randomAig(unsigned nodes)
+{
+  Aig_Man_t* p = Aig_ManStart(nodes);
+  std::mt19937 rng(1);
+  std::vector<Aig_Obj_t*> objs;
+  for (int i = 0; i < 256; i++)
+    objs.push_back(Aig_ObjCreatePi(p));
+  while (Aig_ManNodeNum(p) < (int)nodes)
+  {
+    const size_t n = objs.size();
+    Aig_Obj_t* a = objs[n - 1 - rng() % (n < 1000 ? n : 1000)];
+    Aig_Obj_t* b = objs[rng() % n];
+    objs.push_back(
+        Aig_And(p, Aig_NotCond(a, rng() & 1), Aig_NotCond(b, rng() & 1)));
+  }
+  for (int i = 0; i < 256; i++)
+    Aig_ObjCreatePo(p, objs[objs.size() - 1 - i]);
+  return p;
+}
+
+bool sameOutputs(Aig_Man_t* p, const AIGSimulator& a, const AIGSimulator& b)
+{
+  for (int i = 0; i < Aig_ManPoNum(p); i++)
+  {
+    const Aig_Obj_t* o = Aig_ObjFanin0(Aig_ManPo(p, i));
+    for (int w = 0; w < a.words(); w++)
+      if (a.values(o)[w] != b.values(o)[w])
+        return false;
+  }
+  return true;
+}
+
+void bench(const char* what, Aig_Man_t* p, double seconds)
+{
+  std::cout << what << ": " << Aig_ManNodeNum(p) << " nodes, "
+            << Aig_ManPiNum(p) << " inputs" << std::endl;
+
+  const int words[] = {4, 8, 16};
+  for (unsigned i = 0; i < sizeof(words) / sizeof(words[0]); i++)
+  {
+    AIGSimulator reference(p, words[i]);
+    reference.setKernel(AIGSimulator::SCALAR);
+    reference.randomize(1);
+    reference.simulate();
+
+    const AIGSimulator::Kernel kernels[] = {
+        AIGSimulator::SCALAR, AIGSimulator::AVX2, AIGSimulator::AVX512};
+    for (unsigned k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+      if (!AIGSimulator::supported(kernels[k]))
+        continue;
+
+      AIGSimulator sim(p, words[i]);
+      sim.setKernel(kernels[k]);
+      sim.randomize(1);
+
+      unsigned runs = 0;
+      std::chrono::duration<double> taken(0);
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      while (taken.count() < seconds)
+      {
+        sim.simulate();
+        runs++;
+        taken = std::chrono::steady_clock::now() - start;
+      }
+
+      const double patterns = 64.0 * words[i] * runs / taken.count();
+      std::cout << "  " << AIGSimulator::name(kernels[k]) << ", "
+                << 64 * words[i] << " patterns: " << patterns
+                << " patterns/s, " << patterns * Aig_ManNodeNum(p) / 1e9
+                << " G node-pattern evaluations/s"
+                << (sameOutputs(p, reference, sim) ? "" : ", WRONG OUTPUTS")
+                << std::endl;
+    }
+  }
+}
+}
+
+int main(int argc, char** argv)
+{
+  const unsigned width = (argc > 1) ? atoi(argv[1]) : 64;
+  const unsigned nodes = (argc > 2) ? atoi(argv[2]) : 1000000;
+  const double seconds = (argc > 3) ? atof(argv[3]) : 1.0;
+
+  Aig_Man_t* p = multiplier(width);
+  bench("multiplier", p, seconds);
+  Aig_ManStop(p);
+
+  p = randomAig(nodes);
+  bench("random", p, seconds);
+  Aig_ManStop(p);
+  return 0;
+}
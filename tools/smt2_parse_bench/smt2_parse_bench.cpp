@@ -0,0 +1,145 @@
+/**********
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************/
+
+// Times the bison SMT-LIB2 parser against the hand-written SMT2Parser,
+// over lots of tiny inputs and over one huge one. Neither input has a
+// check-sat, so only parsing and node building are measured.
+//   smt2_parse_bench [tiny-queries] [huge-asserts]
+
+#include "stp/Parser/SMT2Parser.h"
+#include "stp/Parser/parser.h"
+#include "stp/cpp_interface.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace stp;
+
+namespace
+{
+
+// A small query over fresh names, like one of the many a symbolic
+// executor sends.
+std::string tinyQuery(unsigned id)
+{
+  std::ostringstream s;
+  s << "(set-logic QF_ABV)\n"
+    << "(declare-fun a" << id << " () (_ BitVec 32))\n"
+    << "(declare-fun b" << id << " () (_ BitVec 32))\n"
+    << "(declare-fun m" << id
+    << " () (Array (_ BitVec 32) (_ BitVec 8)))\n"
+    << "(assert (bvult (bvadd a" << id << " #x00000004) b" << id << "))\n"
+    << "(assert (let ((?x (select m" << id << " a" << id << ")))"
+    << " (= ((_ zero_extend 24) ?x) (bvand b" << id << " #x000000ff))))\n"
+    << "(assert (not (= ((_ extract 7 0) a" << id << ") (_ bv3 8))))\n";
+  return s.str();
+}
+
+// One long input, where the lexer and node building dominate.
+std::string hugeInput(unsigned asserts)
+{
+  std::ostringstream s;
+  s << "(set-logic QF_BV)\n";
+  for (unsigned i = 0; i < asserts; i++)
+    s << "(declare-fun v" << i << " () (_ BitVec 64))\n";
+  for (unsigned i = 1; i < asserts; i++)
+    s << "(assert (bvsle (bvmul v" << i << " (bvxor v" << i - 1
+      << " #x00000000deadbeef)) (bvsub v" << i - 1 << " (_ bv" << i
+      << " 64))))\n";
+  return s.str();
+}
+
+// Parses the text into a fresh Cpp_interface, so that every run starts
+// with no declarations. Returns the seconds taken.
+double parseOnce(STPMgr& bm, const std::string& text, bool bison)
+{
+  Cpp_interface pi(bm, bm.defaultNodeFactory);
+  pi.startup();
+  GlobalParserBM = &bm;
+  GlobalParserInterface = &pi;
+
+  // Flex wants two NULs at the end, in memory it can write to.
+  std::vector<char> buffer(text.begin(), text.end());
+  buffer.push_back('\0');
+  buffer.push_back('\0');
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  if (bison)
+  {
+    SMT2ScanBuffer(&buffer[0], text.size());
+    SMT2Parse();
+    smt2lex_destroy();
+  }
+  else
+    SMT2Parser(pi).parse(&buffer[0], text.size());
+  std::chrono::duration<double> taken =
+      std::chrono::steady_clock::now() - start;
+
+  GlobalParserInterface = NULL;
+  return taken.count();
+}
+
+void report(const char* what, const char* parser, double seconds,
+            size_t bytes, unsigned queries)
+{
+  std::cout << what << " " << parser << ": " << seconds << "s, "
+            << bytes / seconds / (1024 * 1024) << " MB/s, "
+            << queries / seconds << " queries/s" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+  const unsigned tiny = (argc > 1) ? atoi(argv[1]) : 20000;
+  const unsigned huge = (argc > 2) ? atoi(argv[2]) : 200000;
+
+  STPMgr* bm = new STPMgr;
+
+  std::vector<std::string> queries;
+  size_t tinyBytes = 0;
+  for (unsigned i = 0; i < tiny; i++)
+  {
+    queries.push_back(tinyQuery(i));
+    tinyBytes += queries.back().size();
+  }
+
+  for (int bison = 1; bison >= 0; bison--)
+  {
+    double seconds = 0;
+    for (unsigned i = 0; i < tiny; i++)
+      seconds += parseOnce(*bm, queries[i], bison);
+    report("tiny", bison ? "bison" : "SMT2Parser", seconds, tinyBytes, tiny);
+  }
+
+  const std::string text = hugeInput(huge);
+  for (int bison = 1; bison >= 0; bison--)
+  {
+    const double seconds = parseOnce(*bm, text, bison);
+    report("huge", bison ? "bison" : "SMT2Parser", seconds, text.size(), 1);
+  }
+
+  delete bm;
+  return 0;
+}
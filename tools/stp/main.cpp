@@ -173,6 +173,57 @@ void ExtraMain::create_options()
 "(default)"
 #endif
         )
+      ("disable-cnf-streaming",
+       "build the whole CNF before adding it to the SAT solver")
+      ("disable-aig-refinement",
+       "add clauses for the array refinement axioms directly, rather than "
+       "converting them through the AIG")
+      ("aig-rewrite", po::bool_switch(&(bm->UserFlags.enable_AIG_rewrites_flag)),
+       "rewrite the AIG with ABC before converting it to CNF")
+      ("aig-rewrite-script",
+       po::value<string>(&aig_rewrite_script),
+       "the rewriting steps, comma separated: rw (rewrite), rf (refactor) "
+       "and b (balance)")
+      ("aig-rewrite-max-nodes",
+       po::value<int>(&(bm->UserFlags.aig_rewrite_max_nodes)),
+       "skip the rewriting steps once the AIG has more nodes than this")
+      ("aig-rewrite-step-ms",
+       po::value<int>(&(bm->UserFlags.aig_rewrite_step_ms)),
+       "stop each rewrite or refactor step after this many milliseconds")
+      ("aig-sweep", po::bool_switch(&(bm->UserFlags.aig_sweep_flag)),
+       "merge AIG nodes that SAT sweeping proves equivalent before "
+       "converting the AIG to CNF")
+      ("aig-sweep-max-nodes",
+       po::value<int>(&(bm->UserFlags.aig_sweep_max_nodes)),
+       "skip SAT sweeping for AIGs with more nodes than this")
+      ("aig-sweep-conflicts",
+       po::value<int>(&(bm->UserFlags.aig_sweep_conflicts)),
+       "the SAT conflicts allowed for each equivalence check while sweeping")
+      ("aig-sweep-ms", po::value<int>(&(bm->UserFlags.aig_sweep_ms)),
+       "stop SAT sweeping after this many milliseconds")
+      ("streaming", po::bool_switch(&(bm->UserFlags.streaming_flag)),
+       "free each query's tables once it's answered, for long SMT-LIB2 inputs")
+      ("incremental", po::bool_switch(&(bm->UserFlags.incremental_solving)),
+       "keep the SAT solver and bit-blasted formula between queries")
+      ("portfolio", po::value<int>(&(bm->UserFlags.portfolio_threads)),
+       "race this many differently configured solvers on each query")
+      ("bitblast-threads", po::value<int>(&(bm->UserFlags.bitblast_threads)),
+       "bit-blast independent parts of the query on this many threads")
+      ("independence-slicing",
+       po::bool_switch(&(bm->UserFlags.independence_slicing)),
+       "solve the parts of each query that share no symbols separately")
+      ("model-reuse", po::value<int>(&(bm->UserFlags.model_reuse_size)),
+       "try the models of this many earlier satisfiable queries first")
+      ("unsat-core-cache",
+       po::value<int>(&(bm->UserFlags.unsat_core_cache_size)),
+       "answer queries containing one of this many earlier unsat cores; "
+       "queries are solved incrementally, without the simplifications that "
+       "need the whole input")
+      ("query-cache", po::value<int>(&(bm->UserFlags.query_cache_size)),
+       "remember the answers to this many queries")
+      ("query-cache-file",
+       po::value<string>(&(bm->UserFlags.query_cache_file)),
+       "keep the answers to queries in this file, shared between processes")
   ;
 
   po::options_description refinement_options("Refinement options");
@@ -223,6 +274,10 @@ void ExtraMain::create_options()
   input_options.add_options()
   ("SMTLIB1,m", "use the SMT-LIB1 format parser")
   ("SMTLIB2", "use the SMT-LIB2 format parser")
+  ("smtlib2-rd", po::bool_switch(&(bm->UserFlags.smtlib2_rd_parser_flag)),
+   "parse SMT-LIB2 files with the hand-written parser")
+  ("shm-worker", po::value<std::string>(&shm_worker),
+   "answer queries handed over through this shared-memory segment")
   ("CVC", "use the CVC format parser");
 
   po::options_description output_options("Output options");
@@ -238,6 +293,8 @@ void ExtraMain::create_options()
                              "exit after the CNF has been generated")
       ("timeout,g", po::value<int64_t>(&max_num_confl),
        "Number of conflicts after which the SAT solver gives up. -1 means never (default)")
+      ("max-time", po::value<int64_t>(&(bm->UserFlags.timeout_max_time)),
+       "Wall-clock milliseconds after which a query gives up. -1 means never (default)")
       ("check-sanity,d", "construct counterexample and check it");
 
   cmdline_options.add(general_options)
@@ -348,6 +405,24 @@ int ExtraMain::parse_options(int argc, char** argv)
     bm->UserFlags.propagate_equalities = false;
   }
 
+  if (vm.count("disable-cnf-streaming"))
+  {
+    bm->UserFlags.cnf_streaming_flag = false;
+  }
+
+  if (vm.count("disable-aig-refinement"))
+  {
+    bm->UserFlags.aig_refinement_flag = false;
+  }
+
+  if (vm.count("aig-rewrite-script") &&
+      !bm->UserFlags.setAIGRewriteScript(aig_rewrite_script))
+  {
+    cerr << "Invalid value '" << aig_rewrite_script << "'"
+         << " given to option 'aig-rewrite-script'" << endl;
+    exit(-1);
+  }
+
   if (vm.count("timeout"))
   {
     bm->UserFlags.timeout_max_conflicts = max_num_confl;
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "main_common.h"
 #include "extlib-abc/cnf_short.h"
 #include "stp/Parser/parser.h"
+#include "stp/Parser/SMT2Parser.h"
 #include "stp/cpp_interface.h"
 
 extern void errorHandler(const char* error_msg);
@@ -90,6 +91,7 @@ void Main::printVersionInfo()
 
 void Main::parse_file(ASTVec* AssertsQuery)
 {
+  std::lock_guard<std::mutex> parser_lock(GlobalParserMutex);
   TypeChecker nfTypeCheckSimp(*bm->defaultNodeFactory, *bm);
   TypeChecker nfTypeCheckDefault(*bm->hashingNodeFactory, *bm);
 
@@ -126,8 +128,18 @@ void Main::parse_file(ASTVec* AssertsQuery)
   }
   else if (bm->UserFlags.smtlib2_parser_flag)
   {
-    SMT2Parse();
-    smt2lex_destroy();
+    // The hand-written parser needs the whole input in memory, so it's
+    // only used for files that read_file() has mapped.
+    if (bm->UserFlags.smtlib2_rd_parser_flag && mappedInput.buffer() != NULL)
+    {
+      SMT2Parser(*GlobalParserInterface)
+          .parse(mappedInput.buffer(), mappedInput.size());
+    }
+    else
+    {
+      SMT2Parse();
+      smt2lex_destroy();
+    }
   }
   else
   {
@@ -139,6 +151,7 @@ void Main::parse_file(ASTVec* AssertsQuery)
   {
     fclose(toClose);
   }
+  mappedInput.close();
 }
 
 void Main::print_back(ASTNode& query, ASTNode& asserts)
@@ -192,6 +205,30 @@ void Main::print_back(ASTNode& query, ASTNode& asserts)
 
 void Main::read_file()
 {
+  // Lex straight over the mapped file. Flex dirties the pages it lexes,
+  // which leaves the whole file in private memory, so when streaming
+  // read it through stdio as before.
+  if (!bm->UserFlags.streaming_flag)
+  {
+    if (!mappedInput.open(infile.c_str()))
+    {
+      std::string errorMsg("Cannot open ");
+      errorMsg += infile;
+      FatalError(errorMsg.c_str());
+    }
+
+    if (bm->UserFlags.smtlib1_parser_flag)
+      SMTScanBuffer(mappedInput.buffer(), mappedInput.size());
+    else if (bm->UserFlags.smtlib2_parser_flag)
+    {
+      if (!bm->UserFlags.smtlib2_rd_parser_flag)
+        SMT2ScanBuffer(mappedInput.buffer(), mappedInput.size());
+    }
+    else
+      CVCScanBuffer(mappedInput.buffer(), mappedInput.size());
+    return;
+  }
+
   bool error = false;
   if (bm->UserFlags.smtlib1_parser_flag)
   {
@@ -280,6 +317,23 @@ int Main::main(int argc, char** argv)
                       Ctr_Example.get());
 
   GlobalSTP = stp;
+
+  if (!shm_worker.empty())
+  {
+    SharedQuery segment;
+    if (!segment.open(shm_worker.c_str()))
+    {
+      std::string errorMsg("Cannot open shared-memory segment ");
+      errorMsg += shm_worker;
+      FatalError(errorMsg.c_str());
+    }
+    segment.serve(stp);
+
+    GlobalSTP = NULL;
+    delete stp;
+    return 0;
+  }
+
   // If we're not reading the file from stdin.
   if (!infile.empty())
     read_file();
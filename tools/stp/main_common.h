@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "stp/STPManager/STP.h"
 #include "stp/AST/NodeFactory/TypeChecker.h"
 #include "stp/cpp_interface.h"
+#include "stp/Util/MappedInput.h"
+#include "stp/Interface/SharedQuery.h"
 #include <sys/time.h>
 #include <memory>
 #include <string>
@@ -54,6 +56,7 @@ public:
   STPMgr* bm;
   bool onePrintBack;
   FILE* toClose;
+  stp::MappedInput mappedInput;
 
   virtual int create_and_parse_options(int argc, char** argv);
 
@@ -61,7 +64,11 @@ public:
   std::string infile;
   void check_infile_type();
 
+  // Shared-memory segment to answer queries from, instead of a file.
+  std::string shm_worker;
+
   // For options
+  std::string aig_rewrite_script;
   int64_t max_num_confl;
 };
 
@@ -43,11 +43,6 @@ int main(int argc, char** argv)
   STPMgr stp;
   STPMgr* mgr = &stp;
 
-  Cpp_interface interface(*mgr, mgr->defaultNodeFactory);
-  interface.startup();
-  interface.ignoreCheckSat();
-  stp::GlobalParserInterface = &interface;
-
   Simplifier* simp = new Simplifier(mgr);
   ArrayTransformer* at = new ArrayTransformer(mgr, simp);
   AbsRefine_CounterExample* abs = new AbsRefine_CounterExample(mgr, simp, at);
@@ -55,6 +50,11 @@ int main(int argc, char** argv)
 
   GlobalSTP = new STP(mgr, simp, at, tosat, abs);
 
+  Cpp_interface interface(*mgr, mgr->defaultNodeFactory);
+  interface.startup();
+  interface.ignoreCheckSat();
+  stp::GlobalParserInterface = &interface;
+
   srand(time(NULL));
   stp::GlobalParserBM = &stp;
 